@@ -14,8 +14,17 @@
 // UART Baud Rate (deve ser igual ao do dispositivo que envia)
 #define UART_BAUD   115200
 
-// Arquivo de log
-#define LOG_FILE "/datalog.txt"
+// Arquivo de log (o /datalog.txt antigo não tinha sequência nem instante)
+#define LOG_FILE "/telemetria.csv"
+
+// Quadro binário da Pico: 0xAA 0x55 + registro de 15 bytes (telemetria_module)
+// [0] versão, [1] flags, [2..3] sequência, [4..7] instante ms,
+// [8..13] temperatura/umidade/ângulo em décimos (int16), [14] CRC-8
+#define SYNC_1            0xAA
+#define SYNC_2            0x55
+#define REGISTRO_TAMANHO  15
+#define REGISTRO_VERSAO   1
+#define FLAG_ALERTA       0x01
 
 // Usar HSPI (SPI dedicado)
 SPIClass sdSPI(HSPI);
@@ -25,6 +34,13 @@ String inputBuffer = "";
 bool sdCardOK = false;
 unsigned long recordCount = 0;
 
+// Recepção do quadro binário
+enum EstadoQuadro { AGUARDA_SYNC_1, AGUARDA_SYNC_2, LENDO_REGISTRO };
+EstadoQuadro estadoQuadro = AGUARDA_SYNC_1;
+uint8_t registro[REGISTRO_TAMANHO];
+uint8_t registroPos = 0;
+unsigned long quadrosInvalidos = 0;
+
 // ===============================
 // FUNÇÕES AUXILIARES
 // ===============================
@@ -46,13 +62,56 @@ void createLogHeader() {
   if (!SD.exists(LOG_FILE)) {
     File file = SD.open(LOG_FILE, FILE_WRITE);
     if (file) {
-      file.println("TEMP,UMID,ANGULO,ALERTA");
+      file.println("SEQ,INSTANTE_MS,TEMP,UMID,ANGULO,ALERTA");
       file.close();
     }
   }
 }
 
-// Processa os dados recebidos
+// CRC-8 do registro (polinômio 0x31, início 0xFF), igual ao do firmware
+uint8_t crc8(const uint8_t *dados, int len) {
+  uint8_t crc = 0xFF;
+  for (int i = 0; i < len; i++) {
+    crc ^= dados[i];
+    for (int b = 0; b < 8; b++) {
+      crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x31) : (uint8_t)(crc << 1);
+    }
+  }
+  return crc;
+}
+
+int16_t lerInt16(const uint8_t *p) {
+  return (int16_t)(p[0] | (p[1] << 8));
+}
+
+// Valida o registro binário e grava como linha CSV
+void processRecord(const uint8_t *r) {
+  if (r[0] != REGISTRO_VERSAO || crc8(r, REGISTRO_TAMANHO - 1) != r[REGISTRO_TAMANHO - 1]) {
+    quadrosInvalidos++;
+    return;
+  }
+
+  uint16_t seq = (uint16_t)(r[2] | (r[3] << 8));
+  uint32_t instante = (uint32_t)r[4] | ((uint32_t)r[5] << 8) | ((uint32_t)r[6] << 16) | ((uint32_t)r[7] << 24);
+  int16_t temp = lerInt16(&r[8]);
+  int16_t umid = lerInt16(&r[10]);
+  int16_t ang = lerInt16(&r[12]);
+
+  // Décimos -> texto com uma casa, sem passar por float
+  char linha[64];
+  snprintf(linha, sizeof(linha), "%u,%lu,%s%d.%d,%s%d.%d,%s%d.%d,%d",
+           seq, (unsigned long)instante,
+           temp < 0 ? "-" : "", abs(temp) / 10, abs(temp) % 10,
+           umid < 0 ? "-" : "", abs(umid) / 10, abs(umid) % 10,
+           ang < 0 ? "-" : "", abs(ang) / 10, abs(ang) % 10,
+           (r[1] & FLAG_ALERTA) ? 1 : 0);
+
+  if (sdCardOK) {
+    appendToLog(linha);
+  }
+}
+
+// Processa os dados recebidos (linha de texto do formato antigo, UART_ESP_TEXTO=1 na Pico)
 void processData(String data) {
   data.trim();  // Remove espaços e \n\r
   
@@ -71,9 +130,9 @@ void processData(String data) {
   
   // Se tem 3 vírgulas e pelo menos um dígito, é dado válido
   if (commaCount == 3 && hasDigit) {
-    // Formato válido, salva no SD
+    // Formato válido, salva no SD (sem sequência nem instante)
     if (sdCardOK) {
-      appendToLog(data.c_str());
+      appendToLog((String(",,") + data).c_str());
     }
   }
 }
@@ -106,8 +165,31 @@ void setup() {
 void loop() {
   // Lê dados da Serial (UART0 - pinos TX=1, RX=3)
   while (Serial.available()) {
-    char c = Serial.read();
-    
+    uint8_t b = Serial.read();
+
+    // Quadro binário: 0xAA 0x55 e depois o registro inteiro
+    if (estadoQuadro == LENDO_REGISTRO) {
+      registro[registroPos++] = b;
+      if (registroPos == REGISTRO_TAMANHO) {
+        processRecord(registro);
+        estadoQuadro = AGUARDA_SYNC_1;
+      }
+      continue;
+    }
+    if (estadoQuadro == AGUARDA_SYNC_2) {
+      if (b == SYNC_2) {
+        registroPos = 0;
+        estadoQuadro = LENDO_REGISTRO;
+        continue;
+      }
+      estadoQuadro = AGUARDA_SYNC_1;
+    }
+    if (b == SYNC_1) {
+      estadoQuadro = AGUARDA_SYNC_2;
+      continue;
+    }
+
+    char c = (char)b;
     if (c == '\n') {
       // Linha completa recebida, processa
       processData(inputBuffer);
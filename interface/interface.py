@@ -10,6 +10,8 @@ from flask import Flask, render_template, render_template_string
 import threading
 import paho.mqtt.client as mqtt
 import os  # Usado para identificar o processo correto ao rodar em modo debug
+import json
+import struct
 
 app = Flask(__name__)
 
@@ -17,7 +19,19 @@ BROKER   = "test.mosquitto.org"
 PORT     = 1883                    
 CLIENTID = "mosquito_monitor"      
 
-# Tópicos MQTT monitorados
+# Telemetria agregada: registros binários com todos os campos da cama
+# (src/telemetria_module no firmware). Versão 1, 15 bytes little-endian:
+# versão, flags, sequência, instante (ms), temperatura/umidade/ângulo em décimos, CRC-8.
+# Depois de uma queda de rede o firmware manda a fila atrasada, vários registros
+# concatenados na mesma mensagem (mais antigo primeiro)
+TOPIC_TELEMETRIA = "hospital/cama01/telemetria"
+TELEMETRIA_FORMATO = struct.Struct("<BBHIhhhB")
+TELEMETRIA_VERSAO = 1
+TELEMETRIA_FLAG_ALERTA = 0x01
+# Firmware antigo mandava JSON nesse tópico
+CAMPOS_TELEMETRIA = {"t": "temperatura", "u": "umidade", "a": "angulo"}
+
+# Tópicos antigos, um por campo (só chegam se o firmware tiver MQTT_TOPICOS_SEPARADOS=1)
 TOPICS = {
     "hospital/cama/temperatura": "temperatura",
     "hospital/cama/umidade": "umidade",
@@ -52,11 +66,69 @@ import time
 timeout_segundos = 5
 ultimos_tempos = {k: 0 for k in dados_cama}
 
+def crc8(dados: bytes) -> int:
+    """CRC-8 do registro (polinômio 0x31, início 0xFF), igual ao telemetria_crc8 do firmware."""
+    crc = 0xFF
+    for b in dados:
+        crc ^= b
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x31) & 0xFF if crc & 0x80 else (crc << 1) & 0xFF
+    return crc
+
+def decodificar_telemetria(registro: bytes):
+    """Decodifica o registro binário; devolve None se tamanho, versão ou CRC não baterem."""
+    if len(registro) != TELEMETRIA_FORMATO.size or registro[0] != TELEMETRIA_VERSAO:
+        return None
+    if crc8(registro[:-1]) != registro[-1]:
+        return None
+    _, flags, seq, instante_ms, temp, umid, ang, _ = TELEMETRIA_FORMATO.unpack(registro)
+    return {
+        "seq": seq,
+        "instante_ms": instante_ms,
+        "t": temp / 10,
+        "u": umid / 10,
+        "a": ang / 10,
+        "al": 1 if flags & TELEMETRIA_FLAG_ALERTA else 0,
+    }
+
+def decodificar_lote(payload: bytes):
+    """Separa os registros de uma mensagem; devolve None se algum não for válido."""
+    tamanho = TELEMETRIA_FORMATO.size
+    if len(payload) == 0 or len(payload) % tamanho != 0:
+        return None
+    registros = [decodificar_telemetria(payload[i:i + tamanho]) for i in range(0, len(payload), tamanho)]
+    return None if None in registros else registros
+
+def atualizar_telemetria(payload: bytes):
+    """Espalha a mensagem agregada pelos mesmos campos que os tópicos separados preenchem."""
+    registros = decodificar_lote(payload)
+    if registros is None:
+        try:
+            registros = [json.loads(payload.decode('utf-8'))]
+        except ValueError as e:
+            print(f" Telemetria inválida ({e}): {payload.hex()}")
+            return
+    elif len(registros) > 1:
+        print(f" Lote atrasado: {len(registros)} registros (seq {registros[0]['seq']}..{registros[-1]['seq']})")
+
+    # O painel mostra o valor atual: o registro mais novo do lote
+    dados = registros[-1]
+
+    agora = time.time()
+    for campo, chave in CAMPOS_TELEMETRIA.items():
+        if campo in dados:
+            dados_cama[chave] = f"{float(dados[campo]):.1f}"
+            ultimos_tempos[chave] = agora
+    if "al" in dados:
+        dados_cama["alerta"] = "ATIVO" if dados["al"] else "OK"
+        ultimos_tempos["alerta"] = agora
+    print(f" Telemetria atualizada: {dados_cama}")
+
 # Handlers para conexão e recebimento de mensagens MQTT
 def on_connect(client, userdata, flags, rc):
     if rc == 0:
         print("✅ Conectado ao broker")
-        for topic in TOPICS:
+        for topic in [TOPIC_TELEMETRIA, *TOPICS]:
             result = client.subscribe(topic, qos=1)
             print(f"📝 Subscrito ao tópico: {topic} - Result: {result}")
     else:
@@ -66,11 +138,24 @@ def on_message(client, userdata, msg):
     try:
         # tenta descriptografar o payload recebido
         decrypted_bytes = decrypt_aes_cbc_pkcs7(msg.payload)
-        payload = decrypted_bytes.decode('utf-8').strip()
-        print(f" [RECEBIDO] {msg.topic}: {payload}")
     except Exception as e:
         print(f" Erro ao descriptografar payload do tópico {msg.topic}: {e}")
-        payload = None
+        decrypted_bytes = None
+
+    # A telemetria é binária, não dá pra tratar como texto
+    if msg.topic == TOPIC_TELEMETRIA:
+        if decrypted_bytes is not None:
+            print(f" [RECEBIDO] {msg.topic}: {decrypted_bytes.hex()}")
+            atualizar_telemetria(decrypted_bytes)
+        return
+
+    payload = None
+    if decrypted_bytes is not None:
+        try:
+            payload = decrypted_bytes.decode('utf-8').strip()
+            print(f" [RECEBIDO] {msg.topic}: {payload}")
+        except UnicodeDecodeError as e:
+            print(f" Payload inválido no tópico {msg.topic}: {e}")
 
     chave = TOPICS.get(msg.topic)
     if chave and payload is not None:
@@ -0,0 +1,408 @@
+/**
+ * @file host_dispositivos.c
+ * @brief [host] Modelos simples do MPU6050, AHT10 e SSD1306 nos barramentos simulados
+ *
+ * Os modelos se registram sozinhos antes do main(), nos mesmos endereços
+ * usados na placa: MPU6050 (0x68) e AHT10 (0x38) no I2C0, OLED (0x3C) no I2C1.
+ * Um segundo OLED em 0x3D serve de "backend" de captura: quem quiser ver o que
+ * um ssd1306_show mandaria, inicializa um display nesse endereço e salva a
+ * GDDRAM dele em PBM, sem mexer na tela principal.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+#include "host_hal.h"
+
+// ==================== MPU6050 ====================
+
+#define MPU_FIFO_TAMANHO 1024
+
+static struct {
+    uint8_t regs[128];
+    uint8_t ponteiro;
+    // FIFO: as amostras "nascem" no ritmo do SMPLRT_DIV a partir do instante em que foi ligada
+    uint64_t fifo_inicio_us;
+    uint64_t fifo_consumidas;
+    uint8_t fifo_byte;          // Posição dentro da amostra sendo lida
+    bool fifo_estourou;
+} mpu;
+
+static void mpu_set_reg16(uint8_t reg, int16_t valor) {
+    mpu.regs[reg] = (uint8_t)((uint16_t)valor >> 8);
+    mpu.regs[reg + 1] = (uint8_t)valor;
+}
+
+void host_mpu6050_set_aceleracao(int16_t ax, int16_t ay, int16_t az) {
+    mpu_set_reg16(0x3B, ax);
+    mpu_set_reg16(0x3D, ay);
+    mpu_set_reg16(0x3F, az);
+}
+
+void host_mpu6050_set_giroscopio(int16_t gx, int16_t gy, int16_t gz) {
+    mpu_set_reg16(0x43, gx);
+    mpu_set_reg16(0x45, gy);
+    mpu_set_reg16(0x47, gz);
+}
+
+static uint32_t mpu_fifo_bytes_por_amostra(void) {
+    uint8_t en = mpu.regs[0x23];
+    return ((en & 0x08) ? 6 : 0) + ((en & 0x80) ? 2 : 0) +
+           ((en & 0x40) ? 2 : 0) + ((en & 0x20) ? 2 : 0) + ((en & 0x10) ? 2 : 0);
+}
+
+static uint64_t mpu_fifo_periodo_us(void) {
+    uint8_t dlpf = mpu.regs[0x1A] & 0x07;
+    uint32_t base_hz = (dlpf == 0 || dlpf == 7) ? 8000 : 1000;
+    return 1000000ull * (mpu.regs[0x19] + 1u) / base_hz;
+}
+
+// Amostras esperando na FIFO (simula o descarte das mais antigas quando enche)
+static uint64_t mpu_fifo_pendentes(void) {
+    uint32_t bps = mpu_fifo_bytes_por_amostra();
+    if (!(mpu.regs[0x6A] & 0x40) || bps == 0) return 0;
+
+    uint64_t produzidas = (time_us_64() - mpu.fifo_inicio_us) / mpu_fifo_periodo_us();
+    uint64_t pendentes = produzidas - mpu.fifo_consumidas;
+    if (pendentes * bps > MPU_FIFO_TAMANHO) {
+        mpu.fifo_estourou = true;
+        mpu.fifo_consumidas = produzidas - MPU_FIFO_TAMANHO / bps;
+        pendentes = MPU_FIFO_TAMANHO / bps;
+    }
+    return pendentes;
+}
+
+static uint8_t mpu_fifo_pop(void) {
+    uint32_t bps = mpu_fifo_bytes_por_amostra();
+    if (mpu_fifo_pendentes() == 0) return 0;
+
+    // Ordem da FIFO: acelerômetro, temperatura, giroscópio X/Y/Z
+    uint8_t amostra[14];
+    uint32_t n = 0;
+    uint8_t en = mpu.regs[0x23];
+    if (en & 0x08) { memcpy(&amostra[n], &mpu.regs[0x3B], 6); n += 6; }
+    if (en & 0x80) { memcpy(&amostra[n], &mpu.regs[0x41], 2); n += 2; }
+    if (en & 0x40) { memcpy(&amostra[n], &mpu.regs[0x43], 2); n += 2; }
+    if (en & 0x20) { memcpy(&amostra[n], &mpu.regs[0x45], 2); n += 2; }
+    if (en & 0x10) { memcpy(&amostra[n], &mpu.regs[0x47], 2); n += 2; }
+
+    uint8_t valor = amostra[mpu.fifo_byte];
+    if (++mpu.fifo_byte >= bps) {
+        mpu.fifo_byte = 0;
+        mpu.fifo_consumidas++;
+    }
+    return valor;
+}
+
+static int mpu_escrever(void *ctx, const uint8_t *src, size_t len, bool nostop) {
+    (void)ctx;
+    (void)nostop;
+    if (len == 0) return 0;
+
+    // Primeiro byte é o registrador; os seguintes são gravados em sequência
+    mpu.ponteiro = src[0] & 0x7F;
+    for (size_t i = 1; i < len; i++) {
+        if (mpu.ponteiro == 0x6A && (src[i] & 0x04)) {
+            // FIFO_RESET: esvazia e recomeça a contar a partir de agora
+            mpu.fifo_inicio_us = time_us_64();
+            mpu.fifo_consumidas = 0;
+            mpu.fifo_byte = 0;
+            mpu.fifo_estourou = false;
+        } else if (mpu.ponteiro == 0x6A && (src[i] & 0x40) && !(mpu.regs[0x6A] & 0x40)) {
+            mpu.fifo_inicio_us = time_us_64();
+            mpu.fifo_consumidas = 0;
+        }
+        mpu.regs[mpu.ponteiro] = src[i] & (mpu.ponteiro == 0x6A ? ~0x04 : 0xFF);
+        mpu.ponteiro = (mpu.ponteiro + 1) & 0x7F;
+    }
+    return (int)len;
+}
+
+static int mpu_ler(void *ctx, uint8_t *dst, size_t len, bool nostop) {
+    (void)ctx;
+    (void)nostop;
+    for (size_t i = 0; i < len; i++) {
+        switch (mpu.ponteiro) {
+            case 0x3A: {    // INT_STATUS (limpa ao ler)
+                mpu_fifo_pendentes();
+                dst[i] = mpu.fifo_estourou ? 0x10 : 0x00;
+                mpu.fifo_estourou = false;
+                break;
+            }
+            case 0x72: {
+                uint64_t bytes = mpu_fifo_pendentes() * mpu_fifo_bytes_por_amostra() - mpu.fifo_byte;
+                mpu.regs[0x72] = (uint8_t)(bytes >> 8);
+                mpu.regs[0x73] = (uint8_t)bytes;
+                dst[i] = mpu.regs[0x72];
+                break;
+            }
+            case 0x74:      // FIFO_R_W não avança o ponteiro
+                dst[i] = mpu_fifo_pop();
+                continue;
+            default:
+                dst[i] = mpu.regs[mpu.ponteiro];
+                break;
+        }
+        mpu.ponteiro = (mpu.ponteiro + 1) & 0x7F;
+    }
+    return (int)len;
+}
+
+// ==================== AHT10 ====================
+
+#define AHT10_TEMPO_CONVERSAO_US 75000
+
+static struct {
+    uint32_t umidade_raw;
+    uint32_t temperatura_raw;
+    bool calibrado;
+    uint64_t fim_conversao_us;
+} aht;
+
+void host_aht10_set_medicao(float temperatura, float umidade) {
+    aht.umidade_raw = (uint32_t)(umidade / 100.0f * 1048576.0f) & 0xFFFFF;
+    aht.temperatura_raw = (uint32_t)((temperatura + 50.0f) / 200.0f * 1048576.0f) & 0xFFFFF;
+}
+
+static int aht_escrever(void *ctx, const uint8_t *src, size_t len, bool nostop) {
+    (void)ctx;
+    (void)nostop;
+    if (len == 0) return 0;
+
+    switch (src[0]) {
+        case 0xBA:              // Soft reset
+            aht.calibrado = false;
+            break;
+        case 0xE1:              // Inicialização/calibração
+        case 0xBE:
+            aht.calibrado = true;
+            break;
+        case 0xAC:              // Dispara medição
+            aht.fim_conversao_us = time_us_64() + AHT10_TEMPO_CONVERSAO_US;
+            break;
+        default:
+            break;
+    }
+    return (int)len;
+}
+
+static int aht_ler(void *ctx, uint8_t *dst, size_t len, bool nostop) {
+    (void)ctx;
+    (void)nostop;
+    uint8_t dados[7];
+
+    dados[0] = (aht.calibrado ? 0x08 : 0x00) | (time_us_64() < aht.fim_conversao_us ? 0x80 : 0x00);
+    dados[1] = (uint8_t)(aht.umidade_raw >> 12);
+    dados[2] = (uint8_t)(aht.umidade_raw >> 4);
+    dados[3] = (uint8_t)(((aht.umidade_raw & 0x0F) << 4) | ((aht.temperatura_raw >> 16) & 0x0F));
+    dados[4] = (uint8_t)(aht.temperatura_raw >> 8);
+    dados[5] = (uint8_t)aht.temperatura_raw;
+
+    // 7º byte: CRC-8 no formato do AHT20 (polinômio 0x31, início 0xFF)
+    uint8_t crc = 0xFF;
+    for (int i = 0; i < 6; i++) {
+        crc ^= dados[i];
+        for (int b = 0; b < 8; b++) crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x31) : (uint8_t)(crc << 1);
+    }
+    dados[6] = crc;
+
+    for (size_t i = 0; i < len; i++) {
+        dst[i] = i < sizeof(dados) ? dados[i] : 0xFF;
+    }
+    return (int)len;
+}
+
+// ==================== SSD1306 ====================
+
+#define OLED_COLUNAS 128
+#define OLED_PAGINAS 8
+
+/*
+ * GDDRAM no modo de endereçamento horizontal (o único que o driver usa):
+ * cada byte de dados vai pra (página, coluna) e avança dentro da janela
+ * definida por SET_COL_ADDR/SET_PAGE_ADDR. Os comandos chegam tanto num
+ * bloco só quanto um byte por transação, então o parser guarda o estado.
+ */
+typedef struct {
+    uint8_t gddram[OLED_PAGINAS * OLED_COLUNAS];
+    uint8_t col_ini, col_fim, pag_ini, pag_fim;
+    uint8_t col, pag;
+    uint8_t cmd;                // Comando esperando parâmetros
+    uint8_t args[6];
+    uint8_t n_args, faltam;
+    bool ligado;
+    uint64_t bytes_dados;
+} oled_t;
+
+static oled_t oled_principal;   // 0x3C, o da placa
+static oled_t oled_captura;     // 0x3D (SA0 alto), só pra ferramentas e benchmark no host
+
+static oled_t *oled_no_endereco(uint8_t addr) {
+    return addr == 0x3D ? &oled_captura : &oled_principal;
+}
+
+uint64_t host_ssd1306_bytes_recebidos(void) {
+    return oled_principal.bytes_dados;
+}
+
+const uint8_t *host_ssd1306_gddram(uint8_t addr) {
+    return oled_no_endereco(addr)->gddram;
+}
+
+// Tamanho máximo do PBM da GDDRAM (cabeçalho + 1 bit por pixel)
+#define OLED_PBM_MAX (32 + OLED_COLUNAS * OLED_PAGINAS)
+
+// PBM binário: 1 bit por pixel, MSB primeiro, 1 = preto (pixel aceso sai escuro)
+static size_t oled_montar_pbm(const oled_t *o, uint8_t *dst) {
+    size_t n = (size_t)snprintf((char *)dst, 32, "P4\n%d %d\n", OLED_COLUNAS, OLED_PAGINAS * 8);
+    for (int y = 0; y < OLED_PAGINAS * 8; y++) {
+        uint8_t *linha = &dst[n];
+        memset(linha, 0, OLED_COLUNAS / 8);
+        for (int x = 0; x < OLED_COLUNAS; x++) {
+            if (o->gddram[(y >> 3) * OLED_COLUNAS + x] & (1u << (y & 7))) {
+                linha[x >> 3] |= (uint8_t)(0x80u >> (x & 7));
+            }
+        }
+        n += OLED_COLUNAS / 8;
+    }
+    return n;
+}
+
+bool host_ssd1306_salvar_pbm(uint8_t addr, const char *caminho) {
+    uint8_t pbm[OLED_PBM_MAX];
+    size_t n = oled_montar_pbm(oled_no_endereco(addr), pbm);
+
+    FILE *f = fopen(caminho, "wb");
+    if (!f) return false;
+    bool ok = fwrite(pbm, 1, n, f) == n;
+    return (fclose(f) == 0) && ok;
+}
+
+bool host_ssd1306_comparar_pbm(uint8_t addr, const char *caminho) {
+    uint8_t pbm[OLED_PBM_MAX], referencia[OLED_PBM_MAX + 1];
+    size_t n = oled_montar_pbm(oled_no_endereco(addr), pbm);
+
+    FILE *f = fopen(caminho, "rb");
+    if (!f) return false;
+    size_t lidos = fread(referencia, 1, sizeof(referencia), f);
+    fclose(f);
+    return lidos == n && memcmp(pbm, referencia, n) == 0;
+}
+
+// Quantos bytes de parâmetro cada comando espera
+static uint8_t oled_parametros(uint8_t cmd) {
+    switch (cmd) {
+        case 0x21: case 0x22: case 0xA3:
+            return 2;
+        case 0x26: case 0x27: case 0x2C: case 0x2D:
+            return 6;
+        case 0x29: case 0x2A:
+            return 5;
+        case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xD3:
+        case 0xD5: case 0xD9: case 0xDA: case 0xDB:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+// Content scroll (2Ch/2Dh): gira as páginas B..D entre as colunas E..F em uma coluna
+static void oled_rolar_coluna(oled_t *o, bool esquerda) {
+    uint8_t c0 = o->args[4] & 0x7F, c1 = o->args[5] & 0x7F;
+    if (c1 <= c0) return;
+    for (uint8_t pg = o->args[1] & 0x07; pg <= (o->args[3] & 0x07); pg++) {
+        uint8_t *linha = &o->gddram[pg * OLED_COLUNAS];
+        if (esquerda) {
+            uint8_t primeira = linha[c0];
+            memmove(&linha[c0], &linha[c0 + 1], c1 - c0);
+            linha[c1] = primeira;
+        } else {
+            uint8_t ultima = linha[c1];
+            memmove(&linha[c0 + 1], &linha[c0], c1 - c0);
+            linha[c0] = ultima;
+        }
+    }
+}
+
+static void oled_executar(oled_t *o) {
+    switch (o->cmd) {
+        case 0x21:
+            o->col_ini = o->col = o->args[0] & 0x7F;
+            o->col_fim = o->args[1] & 0x7F;
+            break;
+        case 0x22:
+            o->pag_ini = o->pag = o->args[0] & 0x07;
+            o->pag_fim = o->args[1] & 0x07;
+            break;
+        case 0x2C:
+        case 0x2D:
+            oled_rolar_coluna(o, o->cmd == 0x2D);
+            break;
+        case 0xAE:
+        case 0xAF:
+            o->ligado = o->cmd & 0x01;
+            break;
+        default:
+            break;
+    }
+}
+
+static void oled_comando(oled_t *o, uint8_t b) {
+    if (o->faltam) {
+        o->args[o->n_args++] = b;
+        if (--o->faltam == 0) oled_executar(o);
+        return;
+    }
+    o->cmd = b;
+    o->n_args = 0;
+    o->faltam = oled_parametros(b);
+    if (o->faltam == 0) oled_executar(o);
+}
+
+static void oled_dado(oled_t *o, uint8_t b) {
+    o->gddram[o->pag * OLED_COLUNAS + o->col] = b;
+    o->bytes_dados++;
+    if (o->col != o->col_fim) {
+        o->col = (o->col + 1) & 0x7F;
+        return;
+    }
+    o->col = o->col_ini;
+    o->pag = o->pag == o->pag_fim ? o->pag_ini : (o->pag + 1) & 0x07;
+}
+
+static int ssd1306_escrever(void *ctx, const uint8_t *src, size_t len, bool nostop) {
+    oled_t *o = ctx;
+    (void)nostop;
+    if (len == 0) return 0;
+
+    // Byte de controle 0x40 = dados pra GDDRAM; 0x00 = comandos
+    for (size_t i = 1; i < len; i++) {
+        if (src[0] & 0x40) {
+            oled_dado(o, src[i]);
+        } else {
+            oled_comando(o, src[i]);
+        }
+    }
+    return (int)len;
+}
+
+// ==================== REGISTRO ====================
+
+__attribute__((constructor))
+static void host_dispositivos_registrar(void) {
+    // Cama parada em ~37.5° (no meio da faixa segura), ambiente a 25 °C / 55 %
+    host_mpu6050_set_aceleracao(9974, 0, 12998);
+    host_aht10_set_medicao(25.0f, 55.0f);
+
+    host_i2c_dispositivo_t d_mpu = {"MPU6050", mpu_escrever, mpu_ler, NULL};
+    host_i2c_dispositivo_t d_aht = {"AHT10", aht_escrever, aht_ler, NULL};
+    host_i2c_dispositivo_t d_oled = {"SSD1306", ssd1306_escrever, NULL, &oled_principal};
+    host_i2c_dispositivo_t d_captura = {"SSD1306 (captura)", ssd1306_escrever, NULL, &oled_captura};
+
+    host_i2c_registrar(i2c0, 0x68, &d_mpu);
+    host_i2c_registrar(i2c0, 0x38, &d_aht);
+    host_i2c_registrar(i2c1, 0x3C, &d_oled);
+    host_i2c_registrar(i2c1, 0x3D, &d_captura);
+}
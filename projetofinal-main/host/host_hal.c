@@ -0,0 +1,404 @@
+/**
+ * @file host_hal.c
+ * @brief [host] Implementação dos stubs do pico-sdk (tempo, GPIO, I2C, DMA, IRQ, PWM, UART, clocks)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+
+#include "pico/stdlib.h"
+#include "hardware/gpio.h"
+#include "hardware/i2c.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+#include "hardware/pwm.h"
+#include "hardware/uart.h"
+#include "hardware/clocks.h"
+#include "host_hal.h"
+
+#define HOST_I2C_BARRAMENTOS 2
+#define HOST_I2C_ENDERECOS   128
+
+// ==================== VARIÁVEIS PRIVADAS ====================
+static i2c_hw_t i2c_hw[HOST_I2C_BARRAMENTOS] = {
+    {.status = I2C_IC_STATUS_TFE_BITS},
+    {.status = I2C_IC_STATUS_TFE_BITS},
+};
+i2c_inst_t i2c0_inst = {0, 0, &i2c_hw[0]};
+i2c_inst_t i2c1_inst = {1, 0, &i2c_hw[1]};
+uart_inst_t uart0_inst = {0};
+uart_inst_t uart1_inst = {1};
+
+static host_i2c_dispositivo_t dispositivos[HOST_I2C_BARRAMENTOS][HOST_I2C_ENDERECOS];
+static uint64_t bytes_i2c[HOST_I2C_BARRAMENTOS];
+
+static bool gpio_estado[NUM_BANK0_GPIOS];
+static uint16_t pwm_nivel[8][2];
+
+static FILE *uart_captura = NULL;
+
+volatile uint host_excecao_atual = 0;
+
+#define HOST_IRQS 32
+#define HOST_IRQ_HANDLERS 4
+static irq_handler_t irq_handlers[HOST_IRQS][HOST_IRQ_HANDLERS];
+static bool irq_habilitada[HOST_IRQS];
+
+static struct {
+    bool irq0_habilitada;
+    bool irq0_pendente;
+} dma_canais[NUM_DMA_CHANNELS];
+
+// ==================== TEMPO ====================
+
+static uint64_t relogio_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u;
+}
+
+static uint64_t boot_us = 0;
+
+uint64_t time_us_64(void) {
+    if (boot_us == 0) {
+        boot_us = relogio_us();
+    }
+    return relogio_us() - boot_us;
+}
+
+uint32_t time_us_32(void) {
+    return (uint32_t)time_us_64();
+}
+
+uint32_t to_ms_since_boot(uint64_t t) {
+    return (uint32_t)(t / 1000u);
+}
+
+void sleep_us(uint64_t us) {
+    // A porta POSIX usa sinais pro tick, então o nanosleep pode ser interrompido
+    struct timespec restante = { (time_t)(us / 1000000u), (long)(us % 1000000u) * 1000 };
+    while (nanosleep(&restante, &restante) != 0 && errno == EINTR) {
+    }
+}
+
+void sleep_ms(uint32_t ms) {
+    sleep_us((uint64_t)ms * 1000u);
+}
+
+bool stdio_init_all(void) {
+    setvbuf(stdout, NULL, _IOLBF, 0);
+    time_us_64();
+
+    const char *arquivo = getenv("PROJETO_HOST_UART");
+    if (arquivo) {
+        uart_captura = fopen(arquivo, "wb");
+    }
+    return true;
+}
+
+// ==================== GPIO ====================
+
+void gpio_init(uint gpio) {
+    if (gpio < NUM_BANK0_GPIOS) gpio_estado[gpio] = false;
+}
+
+void gpio_set_function(uint gpio, enum gpio_function fn) {
+    (void)gpio;
+    (void)fn;
+}
+
+void gpio_set_dir(uint gpio, bool out) {
+    (void)gpio;
+    (void)out;
+}
+
+void gpio_pull_up(uint gpio) {
+    if (gpio < NUM_BANK0_GPIOS) gpio_estado[gpio] = true;
+}
+
+void gpio_put(uint gpio, bool value) {
+    if (gpio < NUM_BANK0_GPIOS) gpio_estado[gpio] = value;
+}
+
+bool gpio_get(uint gpio) {
+    return gpio < NUM_BANK0_GPIOS ? gpio_estado[gpio] : false;
+}
+
+void gpio_set_irq_enabled(uint gpio, uint32_t events, bool enabled) {
+    (void)gpio;
+    (void)events;
+    (void)enabled;
+}
+
+void gpio_set_irq_enabled_with_callback(uint gpio, uint32_t events, bool enabled, gpio_irq_callback_t callback) {
+    // Não há botões no host: o callback nunca é chamado
+    (void)callback;
+    gpio_set_irq_enabled(gpio, events, enabled);
+}
+
+// ==================== I2C ====================
+
+bool host_i2c_registrar(i2c_inst_t *i2c, uint8_t addr, const host_i2c_dispositivo_t *disp) {
+    if (i2c->indice >= HOST_I2C_BARRAMENTOS || addr >= HOST_I2C_ENDERECOS) return false;
+    if (dispositivos[i2c->indice][addr].nome) return false;
+
+    dispositivos[i2c->indice][addr] = *disp;
+    return true;
+}
+
+uint64_t host_i2c_bytes_transferidos(i2c_inst_t *i2c) {
+    return bytes_i2c[i2c->indice];
+}
+
+uint i2c_init(i2c_inst_t *i2c, uint baudrate) {
+    i2c->baudrate = baudrate;
+    return baudrate;
+}
+
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop) {
+    if (addr >= HOST_I2C_ENDERECOS) return PICO_ERROR_GENERIC;
+
+    host_i2c_dispositivo_t *d = &dispositivos[i2c->indice][addr];
+    if (!d->escrever) return PICO_ERROR_GENERIC;
+
+    // Endereço + dados, como conta no barramento real
+    bytes_i2c[i2c->indice] += len + 1;
+    return d->escrever(d->ctx, src, len, nostop);
+}
+
+int i2c_read_blocking(i2c_inst_t *i2c, uint8_t addr, uint8_t *dst, size_t len, bool nostop) {
+    if (addr >= HOST_I2C_ENDERECOS) return PICO_ERROR_GENERIC;
+
+    host_i2c_dispositivo_t *d = &dispositivos[i2c->indice][addr];
+    if (!d->ler) return PICO_ERROR_GENERIC;
+
+    bytes_i2c[i2c->indice] += len + 1;
+    return d->ler(d->ctx, dst, len, nostop);
+}
+
+// ==================== IRQ ====================
+
+void irq_add_shared_handler(uint num, irq_handler_t handler, uint8_t order_priority) {
+    (void)order_priority;
+    if (num >= HOST_IRQS) return;
+    for (int i = 0; i < HOST_IRQ_HANDLERS; i++) {
+        if (!irq_handlers[num][i]) {
+            irq_handlers[num][i] = handler;
+            return;
+        }
+    }
+}
+
+void irq_set_enabled(uint num, bool enabled) {
+    if (num < HOST_IRQS) irq_habilitada[num] = enabled;
+}
+
+// Roda os handlers como se fosse a exceção 16 + num
+static void irq_disparar(uint num) {
+    if (num >= HOST_IRQS || !irq_habilitada[num]) return;
+    uint anterior = host_excecao_atual;
+    host_excecao_atual = 16u + num;
+    for (int i = 0; i < HOST_IRQ_HANDLERS && irq_handlers[num][i]; i++) {
+        irq_handlers[num][i]();
+    }
+    host_excecao_atual = anterior;
+}
+
+// ==================== DMA ====================
+
+int dma_claim_unused_channel(bool required) {
+    static bool reservado[NUM_DMA_CHANNELS];
+    for (int i = 0; i < NUM_DMA_CHANNELS; i++) {
+        if (!reservado[i]) {
+            reservado[i] = true;
+            return i;
+        }
+    }
+    if (required) {
+        fprintf(stderr, "[HOST] Sem canal de DMA livre\n");
+        abort();
+    }
+    return -1;
+}
+
+void dma_channel_unclaim(uint channel) {
+    (void)channel;
+}
+
+dma_channel_config dma_channel_get_default_config(uint channel) {
+    (void)channel;
+    dma_channel_config c = {DMA_SIZE_32};
+    return c;
+}
+
+void channel_config_set_transfer_data_size(dma_channel_config *c, enum dma_channel_transfer_size size) {
+    c->ctrl = (uint32_t)size;
+}
+
+void channel_config_set_read_increment(dma_channel_config *c, bool incr) {
+    (void)c;
+    (void)incr;
+}
+
+void channel_config_set_write_increment(dma_channel_config *c, bool incr) {
+    (void)c;
+    (void)incr;
+}
+
+void channel_config_set_dreq(dma_channel_config *c, uint dreq) {
+    (void)c;
+    (void)dreq;
+}
+
+// Converte o fluxo de palavras do data_cmd em transações (uma por bit de STOP)
+static void dma_para_i2c(uint barramento, const uint16_t *palavras, uint n) {
+    i2c_inst_t *i2c = barramento == 0 ? i2c0 : i2c1;
+    uint8_t transacao[2048];
+    size_t len = 0;
+
+    for (uint i = 0; i < n; i++) {
+        if (len < sizeof(transacao)) transacao[len++] = (uint8_t)palavras[i];
+        if (palavras[i] & I2C_IC_DATA_CMD_STOP_BITS) {
+            if (i2c_write_blocking(i2c, (uint8_t)i2c->hw->tar, transacao, len, false) < 0) {
+                i2c->hw->raw_intr_stat |= I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS;
+            }
+            len = 0;
+        }
+    }
+}
+
+void dma_channel_configure(uint channel, const dma_channel_config *config, volatile void *write_addr,
+                           const volatile void *read_addr, uint transfer_count, bool trigger) {
+    if (!trigger || channel >= NUM_DMA_CHANNELS) return;
+
+    for (uint b = 0; b < HOST_I2C_BARRAMENTOS; b++) {
+        if (write_addr == &i2c_hw[b].data_cmd && config->ctrl == DMA_SIZE_16) {
+            dma_para_i2c(b, (const uint16_t *)read_addr, transfer_count);
+        }
+    }
+
+    // Terminou: chama a interrupção do canal
+    if (dma_canais[channel].irq0_habilitada) {
+        dma_canais[channel].irq0_pendente = true;
+        irq_disparar(DMA_IRQ_0);
+    }
+}
+
+// A transferência simulada termina dentro do próprio disparo
+bool dma_channel_is_busy(uint channel) {
+    (void)channel;
+    return false;
+}
+
+void dma_channel_set_irq0_enabled(uint channel, bool enabled) {
+    if (channel < NUM_DMA_CHANNELS) dma_canais[channel].irq0_habilitada = enabled;
+}
+
+bool dma_channel_get_irq0_status(uint channel) {
+    return channel < NUM_DMA_CHANNELS && dma_canais[channel].irq0_pendente;
+}
+
+void dma_channel_acknowledge_irq0(uint channel) {
+    if (channel < NUM_DMA_CHANNELS) dma_canais[channel].irq0_pendente = false;
+}
+
+// ==================== SPIN LOCKS ====================
+
+static spin_lock_t spin_locks[NUM_SPIN_LOCKS];
+static bool spin_lock_reservado[NUM_SPIN_LOCKS];
+
+int spin_lock_claim_unused(bool required) {
+    for (int i = NUM_SPIN_LOCKS - 1; i >= 0; i--) {
+        if (!spin_lock_reservado[i]) {
+            spin_lock_reservado[i] = true;
+            return i;
+        }
+    }
+    if (required) {
+        fprintf(stderr, "[HOST] Sem spin lock livre\n");
+        abort();
+    }
+    return -1;
+}
+
+void spin_lock_unclaim(uint lock_num) {
+    if (lock_num < NUM_SPIN_LOCKS) spin_lock_reservado[lock_num] = false;
+}
+
+spin_lock_t *spin_lock_instance(uint lock_num) {
+    return &spin_locks[lock_num % NUM_SPIN_LOCKS];
+}
+
+uint spin_lock_get_num(spin_lock_t *lock) {
+    return (uint)(lock - spin_locks);
+}
+
+// ==================== PWM ====================
+
+uint pwm_gpio_to_slice_num(uint gpio) {
+    return (gpio >> 1u) & 7u;
+}
+
+uint pwm_gpio_to_channel(uint gpio) {
+    return gpio & 1u;
+}
+
+pwm_config pwm_get_default_config(void) {
+    pwm_config c = {1.0f, 0xffff};
+    return c;
+}
+
+void pwm_config_set_clkdiv(pwm_config *c, float div) {
+    c->clkdiv = div;
+}
+
+void pwm_config_set_wrap(pwm_config *c, uint16_t wrap) {
+    c->wrap = wrap;
+}
+
+void pwm_init(uint slice_num, pwm_config *c, bool start) {
+    (void)slice_num;
+    (void)c;
+    (void)start;
+}
+
+void pwm_set_chan_level(uint slice_num, uint chan, uint16_t level) {
+    pwm_nivel[slice_num & 7u][chan & 1u] = level;
+}
+
+// ==================== UART ====================
+
+uint uart_init(uart_inst_t *uart, uint baudrate) {
+    (void)uart;
+    return baudrate;
+}
+
+void uart_set_format(uart_inst_t *uart, uint data_bits, uint stop_bits, uart_parity_t parity) {
+    (void)uart;
+    (void)data_bits;
+    (void)stop_bits;
+    (void)parity;
+}
+
+void uart_set_fifo_enabled(uart_inst_t *uart, bool enabled) {
+    (void)uart;
+    (void)enabled;
+}
+
+void uart_write_blocking(uart_inst_t *uart, const uint8_t *src, size_t len) {
+    (void)uart;
+    if (uart_captura) {
+        fwrite(src, 1, len, uart_captura);
+        fflush(uart_captura);
+    }
+}
+
+// ==================== CLOCKS ====================
+
+uint32_t clock_get_hz(enum clock_index clk_index) {
+    return clk_index == clk_sys ? 125000000u : 48000000u;
+}
@@ -0,0 +1,111 @@
+/**
+ * @file host_hal.h
+ * @brief [host] Ligação entre os stubs de hardware e os dispositivos simulados
+ *
+ * Só existe no build host (PROJETO_HOST_BUILD). Os drivers do projeto não
+ * incluem este header; ele serve pros modelos de dispositivo e ferramentas.
+ */
+
+#ifndef HOST_HAL_H
+#define HOST_HAL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "hardware/i2c.h"
+
+// ==================== DISPOSITIVOS I2C ====================
+
+/**
+ * @brief Dispositivo I2C simulado
+ *
+ * escrever/ler recebem a transação inteira e devolvem a quantidade de bytes
+ * transferidos (ou PICO_ERROR_GENERIC pra simular NACK).
+ */
+typedef struct {
+    const char *nome;
+    int (*escrever)(void *ctx, const uint8_t *src, size_t len, bool nostop);
+    int (*ler)(void *ctx, uint8_t *dst, size_t len, bool nostop);
+    void *ctx;
+} host_i2c_dispositivo_t;
+
+/**
+ * @brief Registra um dispositivo simulado num endereço do barramento
+ * @return false se o endereço já estiver ocupado
+ */
+bool host_i2c_registrar(i2c_inst_t *i2c, uint8_t addr, const host_i2c_dispositivo_t *disp);
+
+/**
+ * @brief Bytes transferidos (escrita + leitura) num barramento desde o boot
+ */
+uint64_t host_i2c_bytes_transferidos(i2c_inst_t *i2c);
+
+// ==================== MODELOS (host_dispositivos.c) ====================
+
+/**
+ * @brief Define a aceleração bruta que o MPU6050 simulado vai reportar
+ */
+void host_mpu6050_set_aceleracao(int16_t ax, int16_t ay, int16_t az);
+
+/**
+ * @brief Define a velocidade angular bruta (LSB, ±250 °/s) do giroscópio simulado
+ */
+void host_mpu6050_set_giroscopio(int16_t gx, int16_t gy, int16_t gz);
+
+/**
+ * @brief Define a medição que o AHT10 simulado vai reportar
+ */
+void host_aht10_set_medicao(float temperatura, float umidade);
+
+/**
+ * @brief Bytes de dados (GDDRAM) recebidos pelo SSD1306 simulado em 0x3C
+ */
+uint64_t host_ssd1306_bytes_recebidos(void);
+
+/**
+ * @brief GDDRAM (8 páginas x 128 colunas, mesmo layout do buffer do driver)
+ * @param addr 0x3C pro OLED da placa, 0x3D pro OLED de captura
+ */
+const uint8_t *host_ssd1306_gddram(uint8_t addr);
+
+/**
+ * @brief Salva a GDDRAM de um SSD1306 simulado como PBM binário (P4)
+ * @return false se não conseguiu escrever o arquivo
+ */
+bool host_ssd1306_salvar_pbm(uint8_t addr, const char *caminho);
+
+/**
+ * @brief Compara a GDDRAM byte a byte com um PBM salvo (imagem de referência)
+ * @return false se for diferente ou se o arquivo não existir/não puder ser lido
+ */
+bool host_ssd1306_comparar_pbm(uint8_t addr, const char *caminho);
+
+// ==================== REDE (host_lwip.c) ====================
+
+/**
+ * @brief Quantidade de publicações aceitas pelo broker simulado
+ */
+uint32_t host_mqtt_publicacoes(void);
+
+/**
+ * @brief Derruba a conexão com o broker simulado (testa reconexão)
+ */
+void host_mqtt_derrubar_conexao(void);
+
+/**
+ * @brief Faz as publicações QoS 1 pendentes expirarem sem PUBACK (os callbacks
+ * recebem ERR_TIMEOUT, como no MQTT_REQ_TIMEOUT do lwIP)
+ */
+void host_mqtt_expirar_pedidos(void);
+
+/**
+ * @brief As próximas n tentativas de conexão são recusadas (testa o backoff)
+ */
+void host_mqtt_recusar_conexoes(uint32_t n);
+
+/**
+ * @brief Quantos nomes o DNS simulado já resolveu
+ */
+uint32_t host_dns_consultas(void);
+
+#endif // HOST_HAL_H
@@ -0,0 +1,236 @@
+/**
+ * @file host_lwip.c
+ * @brief [host] WiFi, DNS e broker MQTT simulados
+ *
+ * Os callbacks ficam pendentes até o próximo cyw43_arch_poll(), imitando o
+ * comportamento assíncrono do lwIP no firmware. As publicações ocupam um
+ * buffer de saída do tamanho do MQTT_OUTPUT_RINGBUF_SIZE padrão, que só
+ * esvazia no poll (mqtt_publish devolve ERR_MEM quando não cabe). Igual ao
+ * lwIP, toda publicação ocupa um dos MQTT_REQ_MAX_IN_FLIGHT pedidos até
+ * terminar: a QoS 1 até o PUBACK e a QoS 0 até o TCP mandar, os dois no
+ * próximo poll. Com PROJETO_HOST_MQTT_LOG=1
+ * cada publicação aparece no stdout.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "pico/stdlib.h"
+#include "pico/cyw43_arch.h"
+#include "lwip/apps/mqtt.h"
+#include "lwip/dns.h"
+#include "lwip/netif.h"
+#include "host_hal.h"
+
+// 127.0.0.1 em ordem de rede, como o lwIP guarda
+#define HOST_IP_LOOPBACK 0x0100007Fu
+
+// MQTT_OUTPUT_RINGBUF_SIZE padrão do lwIP e os pedidos do lwipopts.h
+#define HOST_MQTT_BUFFER_SAIDA 256
+#define HOST_MQTT_PEDIDOS      MQTT_REQ_MAX_IN_FLIGHT
+
+typedef struct {
+    mqtt_request_cb_t cb;
+    void *arg;
+} host_pedido_t;
+
+struct mqtt_client_s {
+    bool conectado;
+    bool conexao_pendente;
+    bool queda_pendente;
+    uint32_t bytes_na_saida;    // Ocupação do buffer de saída até o próximo poll
+    host_pedido_t pedidos[HOST_MQTT_PEDIDOS];   // Publicações QoS 1 esperando PUBACK
+    int n_pedidos;
+    mqtt_connection_cb_t cb;
+    void *arg;
+};
+
+// ==================== VARIÁVEIS PRIVADAS ====================
+static struct netif netif_host = { {HOST_IP_LOOPBACK}, false };
+struct netif *netif_default = &netif_host;
+
+static struct {
+    bool pendente;
+    char nome[64];
+    dns_found_callback cb;
+    void *arg;
+} dns_pendente;
+
+static mqtt_client_t *cliente_atual = NULL;
+static uint32_t publicacoes = 0;
+static uint32_t conexoes_recusar = 0;
+static uint32_t dns_consultas = 0;
+
+// ==================== CYW43 ====================
+
+int cyw43_arch_init(void) {
+    return 0;
+}
+
+void cyw43_arch_deinit(void) {
+    netif_host.up = false;
+}
+
+void cyw43_arch_enable_sta_mode(void) {
+}
+
+int cyw43_arch_wifi_connect_timeout_ms(const char *ssid, const char *pw, uint32_t auth, uint32_t timeout) {
+    (void)ssid;
+    (void)pw;
+    (void)auth;
+    (void)timeout;
+    netif_host.up = true;
+    return 0;
+}
+
+void cyw43_arch_poll(void) {
+    if (dns_pendente.pendente) {
+        dns_pendente.pendente = false;
+        dns_consultas++;
+        ip_addr_t ip = {HOST_IP_LOOPBACK};
+        dns_pendente.cb(dns_pendente.nome, &ip, dns_pendente.arg);
+    }
+
+    mqtt_client_t *c = cliente_atual;
+    if (!c) return;
+
+    // O TCP "mandou" tudo que estava no buffer de saída (fim das QoS 0) e o
+    // broker confirmou as QoS 1
+    c->bytes_na_saida = 0;
+    int n = c->n_pedidos;
+    c->n_pedidos = 0;
+    for (int i = 0; i < n; i++) {
+        if (c->pedidos[i].cb) c->pedidos[i].cb(c->pedidos[i].arg, ERR_OK);
+    }
+
+    if (c->conexao_pendente && conexoes_recusar > 0) {
+        conexoes_recusar--;
+        c->conexao_pendente = false;
+        if (c->cb) c->cb(c, c->arg, MQTT_CONNECT_REFUSED_SERVER);
+    } else if (c->conexao_pendente) {
+        c->conexao_pendente = false;
+        c->conectado = true;
+        if (c->cb) c->cb(c, c->arg, MQTT_CONNECT_ACCEPTED);
+    } else if (c->queda_pendente) {
+        c->queda_pendente = false;
+        c->conectado = false;
+        if (c->cb) c->cb(c, c->arg, MQTT_CONNECT_DISCONNECTED);
+    }
+}
+
+// ==================== IP / DNS ====================
+
+char *ipaddr_ntoa(const ip_addr_t *addr) {
+    static char str[16];
+    uint32_t a = addr->addr;
+    snprintf(str, sizeof(str), "%u.%u.%u.%u",
+             (unsigned)(a & 0xFF), (unsigned)((a >> 8) & 0xFF),
+             (unsigned)((a >> 16) & 0xFF), (unsigned)(a >> 24));
+    return str;
+}
+
+err_t dns_gethostbyname(const char *hostname, ip_addr_t *addr, dns_found_callback found, void *callback_arg) {
+    (void)addr;
+    if (!netif_host.up) return ERR_CONN;
+
+    dns_pendente.pendente = true;
+    snprintf(dns_pendente.nome, sizeof(dns_pendente.nome), "%s", hostname);
+    dns_pendente.cb = found;
+    dns_pendente.arg = callback_arg;
+    return ERR_INPROGRESS;
+}
+
+// ==================== MQTT ====================
+
+uint32_t host_mqtt_publicacoes(void) {
+    return publicacoes;
+}
+
+void host_mqtt_recusar_conexoes(uint32_t n) {
+    conexoes_recusar = n;
+}
+
+uint32_t host_dns_consultas(void) {
+    return dns_consultas;
+}
+
+void host_mqtt_derrubar_conexao(void) {
+    if (cliente_atual && cliente_atual->conectado) {
+        cliente_atual->queda_pendente = true;
+        cliente_atual->n_pedidos = 0;
+    }
+}
+
+void host_mqtt_expirar_pedidos(void) {
+    mqtt_client_t *c = cliente_atual;
+    if (!c) return;
+
+    int n = c->n_pedidos;
+    c->n_pedidos = 0;
+    for (int i = 0; i < n; i++) {
+        if (c->pedidos[i].cb) c->pedidos[i].cb(c->pedidos[i].arg, ERR_TIMEOUT);
+    }
+}
+
+mqtt_client_t *mqtt_client_new(void) {
+    mqtt_client_t *c = calloc(1, sizeof(mqtt_client_t));
+    cliente_atual = c;
+    return c;
+}
+
+void mqtt_client_free(mqtt_client_t *client) {
+    if (client == cliente_atual) cliente_atual = NULL;
+    free(client);
+}
+
+err_t mqtt_client_connect(mqtt_client_t *client, const ip_addr_t *ipaddr, uint16_t port,
+                          mqtt_connection_cb_t cb, void *arg,
+                          const struct mqtt_connect_client_info_t *client_info) {
+    (void)ipaddr;
+    (void)port;
+    (void)client_info;
+    if (client->conectado || client->conexao_pendente) return ERR_ISCONN;
+
+    client->cb = cb;
+    client->arg = arg;
+    client->conexao_pendente = true;
+    cliente_atual = client;
+    return ERR_OK;
+}
+
+void mqtt_disconnect(mqtt_client_t *client) {
+    client->conectado = false;
+    client->conexao_pendente = false;
+    // Igual ao lwIP: os pedidos pendentes somem sem chamar o callback
+    client->n_pedidos = 0;
+}
+
+uint8_t mqtt_client_is_connected(mqtt_client_t *client) {
+    return client->conectado;
+}
+
+err_t mqtt_publish(mqtt_client_t *client, const char *topic, const void *payload, uint16_t payload_length,
+                   uint8_t qos, uint8_t retain, mqtt_request_cb_t cb, void *arg) {
+    (void)payload;
+    (void)retain;
+    if (!client->conectado) return ERR_CONN;
+
+    // Cabeçalho fixo (até 2 bytes de tamanho) + tamanho do tópico + tópico + payload
+    uint32_t bytes = 1 + 2 + 2 + (uint32_t)strlen(topic) + payload_length;
+    if (client->bytes_na_saida + bytes > HOST_MQTT_BUFFER_SAIDA) return ERR_MEM;
+    if (client->n_pedidos == HOST_MQTT_PEDIDOS) return ERR_MEM;
+    client->bytes_na_saida += bytes;
+
+    publicacoes++;
+    if (getenv("PROJETO_HOST_MQTT_LOG")) {
+        printf("[HOST_BROKER] %s (%u bytes, qos=%u)\n", topic, (unsigned)payload_length, (unsigned)qos);
+    }
+
+    // O pedido fica ocupado até o próximo poll: QoS 0 termina quando o TCP
+    // manda, QoS 1 quando chega o PUBACK
+    client->pedidos[client->n_pedidos].cb = cb;
+    client->pedidos[client->n_pedidos].arg = arg;
+    client->n_pedidos++;
+    return ERR_OK;
+}
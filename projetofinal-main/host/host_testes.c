@@ -0,0 +1,23 @@
+/**
+ * @file host_testes.c
+ * @brief [host] Executável de teste do ctest: roda os benchmarks e as verificações deles
+ *
+ * Confere as telas principais contra as imagens de referência em host/golden/
+ * e o AES contra os vetores do NIST, sem subir o scheduler. Sai com 0 se tudo
+ * bateu e 1 se alguma verificação falhou.
+ */
+
+#include <stdio.h>
+
+#include "pico/stdlib.h"
+#include "security_module/security_module.h"
+#include "benchmark_module/benchmark_module.h"
+
+int main(void) {
+    // Os benchmarks de criptografia usam o contexto guardado do security_module
+    security_init();
+
+    bool ok = benchmark_executar_todos();
+    printf("[TESTES] %s\n", ok ? "OK" : "FALHOU");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,55 @@
+/**
+ * @file i2c.h
+ * @brief [host] Barramentos I2C simulados
+ *
+ * Cada transação é entregue ao dispositivo registrado no endereço
+ * (ver host_hal.h); sem dispositivo, responde como NACK.
+ */
+
+#ifndef HOST_HARDWARE_I2C_H
+#define HOST_HARDWARE_I2C_H
+
+#include "pico/types.h"
+
+// Só os registradores que o projeto toca (o DMA escreve em data_cmd)
+typedef struct {
+    volatile uint32_t enable;
+    volatile uint32_t tar;
+    volatile uint32_t data_cmd;
+    volatile uint32_t status;
+    volatile uint32_t raw_intr_stat;
+    volatile uint32_t clr_tx_abrt;
+} i2c_hw_t;
+
+#define I2C_IC_DATA_CMD_STOP_BITS           0x00000200u
+#define I2C_IC_DATA_CMD_RESTART_BITS        0x00000400u
+#define I2C_IC_STATUS_TFE_BITS              0x00000004u
+#define I2C_IC_STATUS_MST_ACTIVITY_BITS     0x00000020u
+#define I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS   0x00000040u
+
+typedef struct i2c_inst {
+    uint8_t indice;
+    uint32_t baudrate;
+    i2c_hw_t *hw;
+} i2c_inst_t;
+
+extern i2c_inst_t i2c0_inst;
+extern i2c_inst_t i2c1_inst;
+
+#define i2c0 (&i2c0_inst)
+#define i2c1 (&i2c1_inst)
+
+uint i2c_init(i2c_inst_t *i2c, uint baudrate);
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop);
+int i2c_read_blocking(i2c_inst_t *i2c, uint8_t addr, uint8_t *dst, size_t len, bool nostop);
+
+static inline i2c_hw_t *i2c_get_hw(i2c_inst_t *i2c) {
+    return i2c->hw;
+}
+
+// DREQ_I2C0_TX = 32, DREQ_I2C1_TX = 34 (RX é o seguinte)
+static inline uint i2c_get_dreq(i2c_inst_t *i2c, bool is_tx) {
+    return 32u + 2u * i2c->indice + (is_tx ? 0u : 1u);
+}
+
+#endif // HOST_HARDWARE_I2C_H
@@ -0,0 +1,24 @@
+/**
+ * @file pwm.h
+ * @brief [host] PWM simulado (só guarda o nível de cada canal)
+ */
+
+#ifndef HOST_HARDWARE_PWM_H
+#define HOST_HARDWARE_PWM_H
+
+#include "pico/types.h"
+
+typedef struct {
+    float clkdiv;
+    uint16_t wrap;
+} pwm_config;
+
+uint pwm_gpio_to_slice_num(uint gpio);
+uint pwm_gpio_to_channel(uint gpio);
+pwm_config pwm_get_default_config(void);
+void pwm_config_set_clkdiv(pwm_config *c, float div);
+void pwm_config_set_wrap(pwm_config *c, uint16_t wrap);
+void pwm_init(uint slice_num, pwm_config *c, bool start);
+void pwm_set_chan_level(uint slice_num, uint chan, uint16_t level);
+
+#endif // HOST_HARDWARE_PWM_H
@@ -0,0 +1,35 @@
+/**
+ * @file sync.h
+ * @brief [host] Spin locks de hardware simulados com uma flag atômica
+ *
+ * No RP2040 são 32 registradores SIO compartilhados pelos dois núcleos;
+ * aqui cada um vira um byte com test-and-set. Não há interrupções de
+ * verdade pra desligar, então o valor "salvo" é sempre 0.
+ */
+
+#ifndef HOST_HARDWARE_SYNC_H
+#define HOST_HARDWARE_SYNC_H
+
+#include "pico/types.h"
+
+#define NUM_SPIN_LOCKS 32
+
+typedef volatile uint8_t spin_lock_t;
+
+int spin_lock_claim_unused(bool required);
+void spin_lock_unclaim(uint lock_num);
+spin_lock_t *spin_lock_instance(uint lock_num);
+uint spin_lock_get_num(spin_lock_t *lock);
+
+static inline uint32_t spin_lock_blocking(spin_lock_t *lock) {
+    while (__atomic_test_and_set(lock, __ATOMIC_ACQUIRE)) {
+    }
+    return 0;
+}
+
+static inline void spin_unlock(spin_lock_t *lock, uint32_t saved_irq) {
+    (void)saved_irq;
+    __atomic_clear(lock, __ATOMIC_RELEASE);
+}
+
+#endif // HOST_HARDWARE_SYNC_H
@@ -0,0 +1,32 @@
+/**
+ * @file uart.h
+ * @brief [host] UART simulada (bytes enviados vão pro arquivo de captura, se houver)
+ */
+
+#ifndef HOST_HARDWARE_UART_H
+#define HOST_HARDWARE_UART_H
+
+#include "pico/types.h"
+
+typedef struct uart_inst {
+    uint8_t indice;
+} uart_inst_t;
+
+extern uart_inst_t uart0_inst;
+extern uart_inst_t uart1_inst;
+
+#define uart0 (&uart0_inst)
+#define uart1 (&uart1_inst)
+
+typedef enum {
+    UART_PARITY_NONE,
+    UART_PARITY_EVEN,
+    UART_PARITY_ODD
+} uart_parity_t;
+
+uint uart_init(uart_inst_t *uart, uint baudrate);
+void uart_set_format(uart_inst_t *uart, uint data_bits, uint stop_bits, uart_parity_t parity);
+void uart_set_fifo_enabled(uart_inst_t *uart, bool enabled);
+void uart_write_blocking(uart_inst_t *uart, const uint8_t *src, size_t len);
+
+#endif // HOST_HARDWARE_UART_H
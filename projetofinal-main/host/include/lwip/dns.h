@@ -0,0 +1,16 @@
+/**
+ * @file dns.h
+ * @brief [host] Resolução DNS simulada (sempre 127.0.0.1, via cyw43_arch_poll)
+ */
+
+#ifndef HOST_LWIP_DNS_H
+#define HOST_LWIP_DNS_H
+
+#include "lwip/err.h"
+#include "lwip/ip_addr.h"
+
+typedef void (*dns_found_callback)(const char *name, const ip_addr_t *ipaddr, void *callback_arg);
+
+err_t dns_gethostbyname(const char *hostname, ip_addr_t *addr, dns_found_callback found, void *callback_arg);
+
+#endif // HOST_LWIP_DNS_H
@@ -0,0 +1,19 @@
+/**
+ * @file ip_addr.h
+ * @brief [host] Endereço IPv4 no mesmo formato do lwIP
+ */
+
+#ifndef HOST_LWIP_IP_ADDR_H
+#define HOST_LWIP_IP_ADDR_H
+
+#include <stdint.h>
+
+typedef struct ip_addr {
+    uint32_t addr;
+} ip_addr_t;
+
+#define ip_addr_copy(dest, src) ((dest).addr = (src).addr)
+
+char *ipaddr_ntoa(const ip_addr_t *addr);
+
+#endif // HOST_LWIP_IP_ADDR_H
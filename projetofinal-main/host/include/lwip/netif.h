@@ -0,0 +1,21 @@
+/**
+ * @file netif.h
+ * @brief [host] Interface de rede simulada
+ */
+
+#ifndef HOST_LWIP_NETIF_H
+#define HOST_LWIP_NETIF_H
+
+#include <stdbool.h>
+#include "lwip/ip_addr.h"
+
+struct netif {
+    ip_addr_t ip_addr;
+    bool up;
+};
+
+extern struct netif *netif_default;
+
+#define netif_is_up(n) ((n)->up)
+
+#endif // HOST_LWIP_NETIF_H
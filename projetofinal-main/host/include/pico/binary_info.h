@@ -0,0 +1,11 @@
+/**
+ * @file binary_info.h
+ * @brief [host] Sem metadados de binário no build em Linux
+ */
+
+#ifndef HOST_PICO_BINARY_INFO_H
+#define HOST_PICO_BINARY_INFO_H
+
+#define bi_decl(...)
+
+#endif // HOST_PICO_BINARY_INFO_H
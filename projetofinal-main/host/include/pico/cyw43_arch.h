@@ -0,0 +1,27 @@
+/**
+ * @file cyw43_arch.h
+ * @brief [host] Chip WiFi simulado (sempre associa na primeira tentativa)
+ */
+
+#ifndef HOST_PICO_CYW43_ARCH_H
+#define HOST_PICO_CYW43_ARCH_H
+
+#include "pico/types.h"
+
+#define CYW43_AUTH_OPEN         0
+#define CYW43_AUTH_WPA2_AES_PSK 0x00400004
+
+int cyw43_arch_init(void);
+void cyw43_arch_deinit(void);
+void cyw43_arch_enable_sta_mode(void);
+int cyw43_arch_wifi_connect_timeout_ms(const char *ssid, const char *pw, uint32_t auth, uint32_t timeout);
+
+/**
+ * @brief Processa os eventos pendentes da pilha de rede simulada (host_lwip.c)
+ */
+void cyw43_arch_poll(void);
+
+static inline void cyw43_arch_lwip_begin(void) {}
+static inline void cyw43_arch_lwip_end(void) {}
+
+#endif // HOST_PICO_CYW43_ARCH_H
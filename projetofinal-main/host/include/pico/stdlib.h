@@ -0,0 +1,29 @@
+/**
+ * @file stdlib.h
+ * @brief [host] Substituto do pico/stdlib.h para o build em Linux
+ *
+ * Só declara o que o projeto usa; a implementação fica em host/host_hal.c.
+ */
+
+#ifndef HOST_PICO_STDLIB_H
+#define HOST_PICO_STDLIB_H
+
+#include "pico/types.h"
+#include "hardware/gpio.h"
+
+bool stdio_init_all(void);
+
+void sleep_ms(uint32_t ms);
+void sleep_us(uint64_t us);
+uint32_t time_us_32(void);
+uint64_t time_us_64(void);
+uint32_t to_ms_since_boot(uint64_t t);
+
+static inline void tight_loop_contents(void) {}
+
+// Equivalente ao registrador IPSR: só é diferente de zero enquanto um handler
+// simulado (ex.: DMA_IRQ_0 em host_hal.c) está rodando
+extern volatile uint host_excecao_atual;
+static inline uint __get_current_exception(void) { return host_excecao_atual; }
+
+#endif // HOST_PICO_STDLIB_H
@@ -0,0 +1,24 @@
+/**
+ * @file types.h
+ * @brief [host] Tipos básicos do pico-sdk para o build em Linux
+ */
+
+#ifndef HOST_PICO_TYPES_H
+#define HOST_PICO_TYPES_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef unsigned int uint;
+
+// Códigos de erro do pico-sdk (pico/error.h)
+enum pico_error_codes {
+    PICO_OK = 0,
+    PICO_ERROR_NONE = 0,
+    PICO_ERROR_TIMEOUT = -1,
+    PICO_ERROR_GENERIC = -2,
+    PICO_ERROR_NO_DATA = -3,
+};
+
+#endif // HOST_PICO_TYPES_H
@@ -16,7 +16,7 @@
  * -  hospital/cama01/umidade
  * -  hospital/cama01/angulo
  * -  hospital/cama01/status
- * -  hospital/cama01/alerta
+ * -  hospital/cama01/alerta (publicado na hora em que o estado muda)
  * 
  * Pinagem:
  * - I2C0 (MPU6050 + AHT10): SDA=GPIO0, SCL=GPIO1
@@ -57,6 +57,11 @@
 #include "atuadores_module/atuadores_module.h"
 #include "sensores_uart_module/sensores_uart_module.h"
 #include "mqtt_module/mqtt_module.h"
+#include "benchmark_module/benchmark_module.h"
+#include "fusao_module/fusao_module.h"
+#include "display_module/display_module.h"
+#include "telemetria_module/telemetria_module.h"
+#include "imagens.h"          // Gerado no build a partir de assets/ (tools/imagem_para_ssd1306.py)
 
 // ==================== CONFIGURAÇÕES ====================
 #define OLED_WIDTH      128
@@ -67,6 +72,7 @@
 #define TASK_PRIORITY_SENSORES     (tskIDLE_PRIORITY + 3)
 #define TASK_PRIORITY_ALERTAS      (tskIDLE_PRIORITY + 4)
 #define TASK_PRIORITY_DISPLAY      (tskIDLE_PRIORITY + 2)
+#define TASK_PRIORITY_DISPLAY_TX   (tskIDLE_PRIORITY + 3)   // Acima do desenho: no mesmo núcleo nunca fica esperando por ele
 #define TASK_PRIORITY_MQTT         (tskIDLE_PRIORITY + 1)
 #define TASK_PRIORITY_UART         (tskIDLE_PRIORITY + 1)
 #define TASK_PRIORITY_WIFI_MONITOR (tskIDLE_PRIORITY + 2)
@@ -75,120 +81,240 @@
 #define STACK_SIZE_SENSORES     1024
 #define STACK_SIZE_ALERTAS      512
 #define STACK_SIZE_DISPLAY      1024
+#define STACK_SIZE_DISPLAY_TX   256
 #define STACK_SIZE_MQTT         2048
 #define STACK_SIZE_UART         512
 #define STACK_SIZE_WIFI_MONITOR 1024
 
+#ifdef PROJETO_HOST_BUILD
+// No build host cada task é uma pthread, que não aceita pilha menor que PTHREAD_STACK_MIN
+#undef STACK_SIZE_SENSORES
+#undef STACK_SIZE_ALERTAS
+#undef STACK_SIZE_DISPLAY
+#undef STACK_SIZE_DISPLAY_TX
+#undef STACK_SIZE_MQTT
+#undef STACK_SIZE_UART
+#undef STACK_SIZE_WIFI_MONITOR
+#define STACK_SIZE_SENSORES     (configMINIMAL_STACK_SIZE * 2)
+#define STACK_SIZE_ALERTAS      (configMINIMAL_STACK_SIZE * 2)
+#define STACK_SIZE_DISPLAY      (configMINIMAL_STACK_SIZE * 2)
+#define STACK_SIZE_DISPLAY_TX   (configMINIMAL_STACK_SIZE * 2)
+#define STACK_SIZE_MQTT         (configMINIMAL_STACK_SIZE * 2)
+#define STACK_SIZE_UART         (configMINIMAL_STACK_SIZE * 2)
+#define STACK_SIZE_WIFI_MONITOR (configMINIMAL_STACK_SIZE * 2)
+#endif
+
 // De quanto em quanto tempo cada task roda (em milissegundos)
-#define PERIODO_SENSORES_MS     250
-#define PERIODO_ALERTAS_MS      200
+// Sensores: a FIFO do MPU6050 (1 kHz, acel + giro = 12 bytes) enche em ~85ms, então drena bem antes disso
+#define PERIODO_SENSORES_MS     50
+#define PERIODO_AHT10_MS        3000
+#define PERIODO_BUZZER_MS       400     // Cadência do bipe; fora do alerta a task só acorda por notificação
 #define PERIODO_DISPLAY_MS      500
+#define PERIODO_DISPLAY_ALERTA_MS 100
 #define PERIODO_MQTT_MS         5000
+#define PERIODO_MQTT_ESPERA_MS  20      // Espera máxima por um PUBACK (o buffer de saída do lwIP não avisa quando esvazia)
 #define PERIODO_UART_MS         2000
 #define PERIODO_WIFI_MONITOR_MS 10000
 
+// Desenho e envio do display rodam em tasks separadas; com DISPLAY_NO_CORE1 as duas
+// ficam presas no núcleo 1 (precisa de configUSE_CORE_AFFINITY, ver PROJETO_DISPLAY_CORE1 no CMake)
+#if defined(PROJETO_DISPLAY_CORE1) && configUSE_CORE_AFFINITY && configNUM_CORES > 1
+#define DISPLAY_NO_CORE1        1
+#else
+#define DISPLAY_NO_CORE1        0
+#endif
+
+// Drenagem da fila de telemetria depois que o broker volta: no máximo tantos lotes
+// (MQTT_REGISTROS_POR_LOTE cada) e tanto tempo esperando PUBACK por ciclo da task_mqtt
+#define MQTT_LOTES_POR_CICLO    8
+#define MQTT_DRENAGEM_MAX_MS    1000
+
+// A task de envio espera duas coisas diferentes: quadro novo (índice 0) e fim do DMA (índice 1)
+#define NOTIFICACAO_QUADRO      0
+#define NOTIFICACAO_DMA         1
+
 // ==================== ESTRUTURAS DE DADOS ====================
 
 /**
  * Guarda todos os dados importantes do sistema num lugar só.
- * Como várias tasks precisam acessar esses dados, protegemos com mutex.
+ * Como várias tasks (nos dois núcleos) leem esses dados, protegemos com um
+ * seqlock: quem lê nunca bloqueia, só repete a cópia se pegou uma escrita no meio.
  */
 typedef struct {
     float angulo_x;
+    float taxa_angular;       // Velocidade de inclinação (graus/s, do giroscópio)
     float temperatura;
     float umidade;
     bool  alerta_ativo;
     bool  wifi_conectado;
     bool  mqtt_conectado;
     bool  dados_validos;      // Fica true depois da primeira leitura bem-sucedida
+    uint32_t instante_ms;     // Quando os sensores foram lidos (ms desde o boot, vai na telemetria)
 } dados_sistema_t;
 
 // ==================== VARIÁVEIS GLOBAIS ====================
 static ssd1306_t display;
+static bool display_buffer_duplo = false;       // false: desenho e envio dividem o mesmo buffer
 static dados_sistema_t dados_sistema = {0};
+static volatile uint32_t dados_seq = 0;             // Ímpar = escrita em andamento
+
+// Estatísticas do seqlock (um incremento perdido entre núcleos não faz diferença)
+static volatile uint32_t dados_leituras = 0;
+static volatile uint32_t dados_releituras = 0;      // Cópias repetidas por pegar escrita no meio
+
+// Telemetria esperando o broker e filtro de report-by-exception (só a task_mqtt mexe)
+static telemetria_fila_t fila_mqtt;
+static telemetria_filtro_t filtro_mqtt;
 
 // Mutexes — cada um protege um recurso que várias tasks querem usar
 static SemaphoreHandle_t mutex_i2c0 = NULL;   // Barramento dos sensores (MPU6050 + AHT10)
 static SemaphoreHandle_t mutex_i2c1 = NULL;   // Barramento do display OLED
-static SemaphoreHandle_t mutex_dados = NULL;  // Struct compartilhada de dados
+
+// Latência do alerta: do timestamp da amostra que mudou o estado até o gpio_put do LED
+static volatile uint32_t alerta_instante_us = 0;
+static uint32_t alerta_latencia_ultima_us = 0;
+static uint32_t alerta_latencia_max_us = 0;
+static uint32_t alerta_eventos = 0;
+
+// Caminho rápido do alerta pro MQTT: a task dos sensores deixa aqui o estado novo
+// (se mudar de novo antes de sair, vale o mais recente) e acorda a task_mqtt
+static volatile bool alerta_mqtt_pendente = false;
+static volatile bool alerta_mqtt_ativo = false;
+static volatile uint32_t alerta_mqtt_instante_us = 0;
+// Alerta entregue ao lwIP esperando o PUBACK (só a task_mqtt mexe)
+static bool alerta_mqtt_em_voo = false;
+static bool alerta_mqtt_em_voo_ativo = false;
+static uint32_t alerta_mqtt_em_voo_instante_us = 0;
+// Latência do alerta no MQTT: do timestamp da amostra até o PUBACK do broker
+static uint32_t alerta_mqtt_latencia_ultima_us = 0;
+static uint32_t alerta_mqtt_latencia_max_us = 0;
+static uint32_t alerta_mqtt_eventos = 0;
 
 // Referências pra cada task (útil pra debug e monitoramento)
 static TaskHandle_t handle_task_sensores = NULL;
 static TaskHandle_t handle_task_alertas = NULL;
 static TaskHandle_t handle_task_display = NULL;
+static TaskHandle_t handle_task_display_tx = NULL;
 static TaskHandle_t handle_task_mqtt = NULL;
 static TaskHandle_t handle_task_uart = NULL;
 static TaskHandle_t handle_task_wifi_monitor = NULL;
 
 // ==================== FUNÇÕES AUXILIARES ====================
 
-// Copia os dados do sistema de forma segura (com mutex, pra nenhuma task pisar na outra)
+// Escrita no seqlock: a seção crítica serializa os escritores (sensores, MQTT,
+// WiFi) e é curtinha, só o tempo de copiar uns campos
+#define DADOS_ESCRITA_INICIO()  do { taskENTER_CRITICAL(); dados_seq++; __atomic_thread_fence(__ATOMIC_SEQ_CST); } while (0)
+#define DADOS_ESCRITA_FIM()     do { __atomic_thread_fence(__ATOMIC_SEQ_CST); dados_seq++; taskEXIT_CRITICAL(); } while (0)
+
+// Copia os dados do sistema sem travar: se uma escrita aconteceu durante a cópia, copia de novo
 static void dados_sistema_ler(dados_sistema_t *dest) {
-    if (xSemaphoreTake(mutex_dados, pdMS_TO_TICKS(50)) == pdTRUE) {
-        *dest = dados_sistema;
-        xSemaphoreGive(mutex_dados);
+    uint32_t antes, depois;
+    dados_leituras++;
+    for (;;) {
+        antes = dados_seq;
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        if (!(antes & 1u)) {
+            memcpy(dest, &dados_sistema, sizeof(*dest));
+            __atomic_thread_fence(__ATOMIC_SEQ_CST);
+            depois = dados_seq;
+            if (antes == depois) return;
+        }
+        dados_releituras++;
     }
 }
 
 // Salva os valores novos dos sensores na struct compartilhada
-static void dados_sistema_atualizar_sensores(float angulo, float temp, float umid, bool dados_ok) {
-    if (xSemaphoreTake(mutex_dados, pdMS_TO_TICKS(50)) == pdTRUE) {
-        dados_sistema.angulo_x = angulo;
-        dados_sistema.temperatura = temp;
-        dados_sistema.umidade = umid;
-        dados_sistema.alerta_ativo = !angulo_na_faixa(angulo);
-        dados_sistema.dados_validos = dados_ok;
-        xSemaphoreGive(mutex_dados);
-    }
+static void dados_sistema_atualizar_sensores(float angulo, float taxa, float temp, float umid,
+                                             bool alerta, bool dados_ok) {
+    DADOS_ESCRITA_INICIO();
+    dados_sistema.angulo_x = angulo;
+    dados_sistema.taxa_angular = taxa;
+    dados_sistema.temperatura = temp;
+    dados_sistema.umidade = umid;
+    dados_sistema.alerta_ativo = alerta;
+    dados_sistema.dados_validos = dados_ok;
+    dados_sistema.instante_ms = (uint32_t)(time_us_64() / 1000);
+    DADOS_ESCRITA_FIM();
 }
 
 static void dados_sistema_atualizar_conectividade(bool wifi, bool mqtt) {
-    if (xSemaphoreTake(mutex_dados, pdMS_TO_TICKS(50)) == pdTRUE) {
-        dados_sistema.wifi_conectado = wifi;
-        dados_sistema.mqtt_conectado = mqtt;
-        xSemaphoreGive(mutex_dados);
-    }
+    DADOS_ESCRITA_INICIO();
+    dados_sistema.wifi_conectado = wifi;
+    dados_sistema.mqtt_conectado = mqtt;
+    DADOS_ESCRITA_FIM();
+}
+
+// Chamada pela interrupção do DMA quando o quadro terminou de ir pro OLED
+static void display_transferencia_concluida(void *ctx) {
+    (void)ctx;
+    // Telas do boot são mostradas antes das tasks existirem
+    if (handle_task_display_tx == NULL) return;
+    
+    BaseType_t acordou = pdFALSE;
+    vTaskNotifyGiveIndexedFromISR(handle_task_display_tx, NOTIFICACAO_DMA, &acordou);
+    portYIELD_FROM_ISR(acordou);
+}
+
+// Chamada pelo mqtt_module a cada evento de rede (PUBACK de lote, DNS, conexão
+// aceita ou caída): acorda a task_mqtt pra andar a conexão ou mandar o próximo lote
+static void mqtt_evento_rede(void) {
+#ifdef PROJETO_HOST_BUILD
+    // No host o broker simulado responde de dentro do cyw43_arch_poll (contexto de task)
+    xTaskNotifyGive(handle_task_mqtt);
+#else
+    // No firmware o lwIP roda no contexto assíncrono do cyw43 (interrupção de baixa prioridade)
+    BaseType_t acordou = pdFALSE;
+    vTaskNotifyGiveFromISR(handle_task_mqtt, &acordou);
+    portYIELD_FROM_ISR(acordou);
+#endif
 }
 
 // ==================== TASKS DO FREERTOS ====================
 
 /**
- * Task dos sensores — roda a cada 250ms
+ * Task dos sensores — roda a cada 50ms
  * 
- * Lê o acelerômetro (MPU6050) pra saber o ângulo da cama
- * e o sensor de temperatura/umidade (AHT10) a cada ~3 segundos.
+ * O MPU6050 amostra sozinho a 1 kHz na FIFO; aqui a gente só drena o bloco
+ * acumulado numa rajada I2C e passa cada amostra pelo filtro complementar
+ * (giroscópio + acelerômetro), que não pula quando o servo mexe a cama.
+ * O sensor de temperatura/umidade (AHT10) é disparado a cada ~3 segundos e
+ * consultado a cada ciclo até terminar a conversão, sem parar o MPU6050.
  * Tudo passa pelo I2C0, então trava o mutex antes de cada acesso.
+ * Quando o alerta muda de estado, notifica a task_alertas direto.
  */
 static void task_sensores(void *pvParameters) {
     (void)pvParameters;
     
-    int16_t ax, ay, az;
-    float angulo_x = 0;
+    static mpu6050_amostra_t amostras[MPU6050_FIFO_MAX_AMOSTRAS];
+    static fusao_t fusao;
+    float angulo_x = 0, taxa_angular = 0;
     float temperatura = 0, umidade = 0;
+    aht10_t aht = {0};
     int contador_aht = 0;
     bool dados_temp_validos = false;
+    bool fifo_ok = false;
+    bool alerta_atual = false;
     
     printf("[TASK_SENSORES] Iniciada (prioridade=%lu)\n", 
            (unsigned long)uxTaskPriorityGet(NULL));
     
-    // Acorda o MPU6050 (tirar do modo sleep escrevendo 0 no registrador 0x6B)
+    // Acorda o MPU6050 e liga a amostragem automática na FIFO
     if (xSemaphoreTake(mutex_i2c0, pdMS_TO_TICKS(200)) == pdTRUE) {
-        uint8_t reset[2] = {0x6B, 0x00};
-        i2c_write_blocking(i2c0, 0x68, reset, 2, false);
+        fifo_ok = mpu6050_fifo_init(MPU6050_FIFO_TAXA_HZ);
         xSemaphoreGive(mutex_i2c0);
-        printf("[TASK_SENSORES] MPU6050 inicializado\n");
+        printf("[TASK_SENSORES] MPU6050 inicializado (FIFO %s, %d Hz)\n",
+               fifo_ok ? "OK" : "FALHOU", MPU6050_FIFO_TAXA_HZ);
     }
     
+    fusao_init(&fusao);
     vTaskDelay(pdMS_TO_TICKS(100));
     
     // Reseta e configura o AHT10 (calibração inicial)
     if (xSemaphoreTake(mutex_i2c0, pdMS_TO_TICKS(200)) == pdTRUE) {
-        uint8_t reset_cmd = 0xBA;
-        i2c_write_blocking(i2c0, 0x38, &reset_cmd, 1, false);
+        aht10_soft_reset();
         vTaskDelay(pdMS_TO_TICKS(20));
         
-        uint8_t cmd[] = {0xE1, 0x08, 0x00};
-        i2c_write_blocking(i2c0, 0x38, cmd, 3, false);
+        aht10_init();
         xSemaphoreGive(mutex_i2c0);
         printf("[TASK_SENSORES] AHT10 inicializado\n");
     }
@@ -198,73 +324,112 @@ static void task_sensores(void *pvParameters) {
     TickType_t xLastWakeTime = xTaskGetTickCount();
     
     for (;;) {
-        // Lê o acelerômetro e calcula o ângulo de inclinação
-        if (xSemaphoreTake(mutex_i2c0, pdMS_TO_TICKS(100)) == pdTRUE) {
-            mpu6050_read_raw(&ax, &ay, &az);
+        bool alerta_antes = alerta_atual;
+        uint32_t instante_mudanca_us = 0;
+        
+        // Dispara uma medição de temperatura/umidade a cada ~3s (não precisa ser tão frequente)
+        if (++contador_aht >= PERIODO_AHT10_MS / PERIODO_SENSORES_MS && aht.estado == AHT10_OCIOSO) {
+            contador_aht = 0;
+            if (xSemaphoreTake(mutex_i2c0, pdMS_TO_TICKS(100)) == pdTRUE) {
+                aht10_iniciar_medicao(&aht, time_us_32());
+                xSemaphoreGive(mutex_i2c0);
+            }
+        }
+        
+        // Conversão em andamento: uma leitura rápida do status, o resultado vem junto se já acabou
+        if (aht.estado == AHT10_CONVERTENDO &&
+            xSemaphoreTake(mutex_i2c0, pdMS_TO_TICKS(100)) == pdTRUE) {
+            aht10_estado_t estado = aht10_poll(&aht, time_us_32());
+            
+            if (estado == AHT10_PRONTO) {
+                temperatura = aht.temperatura;
+                umidade = aht.umidade;
+                dados_temp_validos = true;
+                printf("[SENSORES] Temp: %.1fC, Umid: %.1f%%\n", temperatura, umidade);
+            }
             xSemaphoreGive(mutex_i2c0);
-            angulo_x = mpu6050_get_inclination(ax, ay, az);
         }
         
-        // Lê temperatura e umidade a cada ~3s (não precisa ser tão frequente)
-        if (++contador_aht >= 12) {
-            contador_aht = 0;
+        // Falhou no disparo ou na leitura: sem isso o AHT10 ficaria em ERRO pra sempre
+        // (só dispara de novo a partir do OCIOSO)
+        if (aht.estado == AHT10_ERRO &&
+            xSemaphoreTake(mutex_i2c0, pdMS_TO_TICKS(100)) == pdTRUE) {
+            printf("[SENSORES] AHT10 erro leitura (status=0x%02X)\n", aht.status);
+            // Perdeu a calibração (ex.: queda de energia no sensor): inicializa de novo
+            if (!(aht.status & AHT10_STATUS_CALIBRADO)) {
+                aht10_init();
+            }
+            aht.estado = AHT10_OCIOSO;
+            xSemaphoreGive(mutex_i2c0);
+        }
+        
+        // Drena o bloco de amostras da FIFO e atualiza o ângulo filtrado
+        if (xSemaphoreTake(mutex_i2c0, pdMS_TO_TICKS(100)) == pdTRUE) {
+            int n;
+            if (fifo_ok) {
+                n = mpu6050_fifo_read(amostras, MPU6050_FIFO_MAX_AMOSTRAS, time_us_32());
+            } else {
+                // Sem FIFO: cai pro modo antigo, uma leitura por ciclo
+                mpu6050_read_raw(&amostras[0].ax, &amostras[0].ay, &amostras[0].az);
+                mpu6050_read_gyro_raw(&amostras[0].gx, &amostras[0].gy, &amostras[0].gz);
+                amostras[0].timestamp_us = time_us_32();
+                n = 1;
+            }
+            xSemaphoreGive(mutex_i2c0);
             
-            if (xSemaphoreTake(mutex_i2c0, pdMS_TO_TICKS(200)) == pdTRUE) {
-                // Manda o AHT10 fazer uma medição
-                uint8_t cmd[] = {0xAC, 0x33, 0x00};
-                i2c_write_blocking(i2c0, 0x38, cmd, 3, false);
-                
-                // Solta o I2C enquanto espera (assim outras tasks podem usar)
-                xSemaphoreGive(mutex_i2c0);
-                vTaskDelay(pdMS_TO_TICKS(80));
-                
-                // Agora pega o resultado da medição
-                if (xSemaphoreTake(mutex_i2c0, pdMS_TO_TICKS(200)) == pdTRUE) {
-                    uint8_t data[6] = {0};
-                    int res = i2c_read_blocking(i2c0, 0x38, data, 6, false);
-                    xSemaphoreGive(mutex_i2c0);
-                    
-                    if (res == 6 && !(data[0] & 0x80)) {
-                        uint32_t hum_raw = ((uint32_t)data[1] << 12) | 
-                                          ((uint32_t)data[2] << 4) | 
-                                          ((data[3] >> 4) & 0x0F);
-                        uint32_t temp_raw = (((uint32_t)data[3] & 0x0F) << 16) | 
-                                           ((uint32_t)data[4] << 8) | data[5];
-                        
-                        umidade = ((float)hum_raw / 1048576.0f) * 100.0f;
-                        temperatura = ((float)temp_raw / 1048576.0f) * 200.0f - 50.0f;
-                        dados_temp_validos = true;
-                        
-                        printf("[SENSORES] Temp: %.1fC, Umid: %.1f%%\n", 
-                               temperatura, umidade);
-                    } else {
-                        printf("[SENSORES] AHT10 erro leitura (res=%d, status=0x%02X)\n", 
-                               res, data[0]);
-                    }
+            // Amostra por amostra, pra saber exatamente qual delas mudou o estado do alerta
+            for (int i = 0; i < n; i++) {
+                fusao_processar_bloco(&fusao, &amostras[i], 1);
+                bool alerta = !angulo_decimos_na_faixa(fusao_angulo_decimos(&fusao));
+                if (alerta != alerta_atual) {
+                    instante_mudanca_us = amostras[i].timestamp_us;
                 }
+                alerta_atual = alerta;
+            }
+            if (n > 0) {
+                angulo_x = fusao_angulo_decimos(&fusao) / 10.0f;
+                taxa_angular = fusao_taxa_decimos(&fusao) / 10.0f;
+            } else if (n < 0) {
+                printf("[SENSORES] FIFO do MPU6050 estourou/falhou, reiniciada\n");
             }
         }
         
         // Salva tudo na struct global pras outras tasks usarem
-        dados_sistema_atualizar_sensores(angulo_x, temperatura, umidade, dados_temp_validos);
+        dados_sistema_atualizar_sensores(angulo_x, taxa_angular, temperatura, umidade,
+                                         alerta_atual, dados_temp_validos);
+        
+        // Mudou o estado do alerta: acorda a task_alertas e a task_mqtt na hora,
+        // sem esperar o próximo ciclo delas
+        if (alerta_atual != alerta_antes) {
+            alerta_instante_us = instante_mudanca_us;
+            xTaskNotifyGive(handle_task_alertas);
+            
+            taskENTER_CRITICAL();
+            alerta_mqtt_ativo = alerta_atual;
+            alerta_mqtt_instante_us = instante_mudanca_us;
+            alerta_mqtt_pendente = true;
+            taskEXIT_CRITICAL();
+            if (handle_task_mqtt) {
+                xTaskNotifyGive(handle_task_mqtt);
+            }
+        }
         
-        // Espera até o próximo ciclo de 250ms
+        // Espera até o próximo ciclo de 50ms
         vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(PERIODO_SENSORES_MS));
     }
 }
 
 /**
- * Task dos alertas — roda a cada 200ms (é a mais rápida)
+ * Task dos alertas — dorme até a task dos sensores avisar que o alerta mudou
  * 
- * Fica de olho no ângulo da cama: se saiu da faixa segura,
- * liga o LED, faz o buzzer apitar e move o servo pra tentar corrigir.
- * Quando tá tudo certo, desliga tudo e deixa o servo no neutro.
+ * Se a cama saiu da faixa segura, liga o LED na hora, faz o buzzer apitar
+ * e move o servo pra tentar corrigir. Enquanto o alerta dura, acorda
+ * sozinha só pra cadência do buzzer. Quando volta tudo ao normal,
+ * desliga tudo e deixa o servo no neutro.
  */
 static void task_alertas(void *pvParameters) {
     (void)pvParameters;
     
-    int contador_buzzer = 0;
-    
     printf("[TASK_ALERTAS] Iniciada (prioridade=%lu)\n", 
            (unsigned long)uxTaskPriorityGet(NULL));
     
@@ -272,134 +437,230 @@ static void task_alertas(void *pvParameters) {
     alertas_init();
     servo_init();
     
-    TickType_t xLastWakeTime = xTaskGetTickCount();
+    bool alerta_anterior = false;
+    servo_set_angle(90);
     
     for (;;) {
+        // Sem alerta não tem o que fazer até a próxima notificação
+        TickType_t espera = alerta_anterior ? pdMS_TO_TICKS(PERIODO_BUZZER_MS) : portMAX_DELAY;
+        bool notificada = ulTaskNotifyTake(pdTRUE, espera) > 0;
+        
         dados_sistema_t local;
         dados_sistema_ler(&local);
+        uint32_t instante_led_us = 0;
         
         if (local.alerta_ativo) {
             // Acende o LED vermelho
             gpio_put(LED_PIN, 1);
+            instante_led_us = time_us_32();
             
-            // Buzzer bipa de forma alternada (liga/desliga a cada ciclo)
-            if (++contador_buzzer % 2 == 0) {
-                buzzer_toggle();
-            }
+            // Buzzer bipa de forma alternada (liga/desliga a cada período)
+            buzzer_toggle();
             
             // Move o servo tentando corrigir a inclinação
             uint angulo_servo = calcular_angulo_servo(local.angulo_x);
             servo_set_angle(angulo_servo);
-        } else {
+        } else if (alerta_anterior) {
             // Tudo normal: desliga LED e buzzer
             gpio_put(LED_PIN, 0);
+            instante_led_us = time_us_32();
             gpio_put(BUZZER_PIN, 0);
-            contador_buzzer = 0;
             
             // Servo volta pro centro (90°)
             servo_set_angle(90);
         }
         
-        vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(PERIODO_ALERTAS_MS));
+        // Mede só as mudanças de estado avisadas pela task dos sensores
+        if (notificada && local.alerta_ativo != alerta_anterior) {
+            alerta_latencia_ultima_us = instante_led_us - alerta_instante_us;
+            if (alerta_latencia_ultima_us > alerta_latencia_max_us) {
+                alerta_latencia_max_us = alerta_latencia_ultima_us;
+            }
+            alerta_eventos++;
+        }
+        alerta_anterior = local.alerta_ativo;
     }
 }
 
+// Arredonda pra décimos (os widgets do display trabalham com inteiros)
+static int16_t para_decimos(float valor) {
+    return (int16_t)(valor * 10.0f + (valor >= 0 ? 0.5f : -0.5f));
+}
+
 /**
- * Task do display — atualiza a tela OLED a cada 500ms
+ * Task do display — atualiza a tela OLED a cada 500ms (100ms durante alerta)
  * 
  * Mostra na telinha tudo que tá acontecendo: ângulo da cama,
  * temperatura, umidade, se o WiFi e o MQTT estão conectados,
  * e um alerta visual quando algo sai da faixa.
+ * Os widgets só redesenham o que mudou; se nada mudou, nem acorda o envio.
+ * Quem manda o quadro pro OLED é a task_display_tx, enquanto esta já
+ * desenha o próximo no outro buffer. Se não deu pra alocar o segundo
+ * buffer, esta task desenha e envia sozinha, tudo dentro do mutex do I2C1.
  */
 static void task_display(void *pvParameters) {
     (void)pvParameters;
     
-    char buffer[32];
-    
     printf("[TASK_DISPLAY] Iniciada (prioridade=%lu)\n", 
            (unsigned long)uxTaskPriorityGet(NULL));
     
+    display_tela_principal_init(&display);
+    
     TickType_t xLastWakeTime = xTaskGetTickCount();
+    TickType_t ultimo_relatorio = xLastWakeTime;
+    uint32_t quadros = 0, quadros_enviados = 0;
     
     for (;;) {
         dados_sistema_t local;
         dados_sistema_ler(&local);
         
-        if (xSemaphoreTake(mutex_i2c1, pdMS_TO_TICKS(100)) == pdTRUE) {
-            ssd1306_clear(&display);
-            
-            // Título fixo no topo
-            ssd1306_draw_string(&display, 0, 0, 1, "CAMA HOSPITALAR");
-            
-            // Mostra "W" se WiFi ok e "M" se MQTT ok (canto superior direito)
-            if (local.wifi_conectado) {
-                ssd1306_draw_string(&display, 90, 0, 1, "W");
-            }
-            if (local.mqtt_conectado) {
-                ssd1306_draw_string(&display, 100, 0, 1, "M");
-            }
-            
-            // "F" indica que o FreeRTOS tá rodando
-            ssd1306_draw_string(&display, 115, 0, 1, "F");
-            
-            ssd1306_draw_line(&display, 0, 10, 127, 10);
-            
-            // Mostra o ângulo atual da cama
-            snprintf(buffer, sizeof(buffer), "Angulo: %.1f", local.angulo_x);
-            ssd1306_draw_string(&display, 0, 14, 1, buffer);
-            
-            // Avisa se o ângulo tá fora da faixa aceitável
-            if (local.alerta_ativo) {
-                if (local.angulo_x < ANGULO_MIN) {
-                    ssd1306_draw_string(&display, 0, 24, 1, "! BAIXO !");
-                } else {
-                    ssd1306_draw_string(&display, 0, 24, 1, "! ALTO !");
-                }
-            } else {
-                ssd1306_draw_string(&display, 0, 24, 1, "OK (30-45)");
-            }
-            
-            ssd1306_draw_line(&display, 0, 34, 127, 34);
+        display_valores_t valores = {
+            .angulo_decimos = para_decimos(local.angulo_x),
+            .temperatura_decimos = para_decimos(local.temperatura),
+            .umidade_decimos = para_decimos(local.umidade),
+            .dados_validos = local.dados_validos,
+            .alerta_ativo = local.alerta_ativo,
+            .wifi_conectado = local.wifi_conectado,
+            .mqtt_conectado = local.mqtt_conectado,
+            .tarefas = (uint8_t)uxTaskGetNumberOfTasks(),
+        };
+        
+        if (display_buffer_duplo) {
+            // Desenhar só mexe no buffer de trás (RAM), não precisa do mutex
+            uint8_t paginas = display_tela_principal_atualizar(&valores, to_ms_since_boot(time_us_64()));
+            quadros++;
             
-            // Temperatura e umidade (mostra "Lendo..." enquanto não tem dados)
-            if (local.dados_validos) {
-                snprintf(buffer, sizeof(buffer), "Temp: %.1f C", local.temperatura);
-                ssd1306_draw_string(&display, 0, 38, 1, buffer);
-                
-                snprintf(buffer, sizeof(buffer), "Umid: %.1f %%", local.umidade);
-                ssd1306_draw_string(&display, 0, 48, 1, buffer);
-            } else {
-                ssd1306_draw_string(&display, 0, 38, 1, "Temp: Lendo...");
-                ssd1306_draw_string(&display, 0, 48, 1, "Umid: Lendo...");
+            if (paginas) {
+                // Troca os buffers e acorda o envio; se ele ainda estiver com um quadro
+                // antigo, as notificações se juntam e vai só o mais recente
+                ssd1306_swap(&display);
+                xTaskNotifyGiveIndexed(handle_task_display_tx, NOTIFICACAO_QUADRO);
+                quadros_enviados++;
             }
+        } else if (xSemaphoreTake(mutex_i2c1, pdMS_TO_TICKS(100)) == pdTRUE) {
+            // Um buffer só: o envio lê o mesmo buffer em que se desenha, então os
+            // dois vão juntos dentro do mutex (envio bloqueante, sem a task_display_tx)
+            uint8_t paginas = display_tela_principal_atualizar(&valores, to_ms_since_boot(time_us_64()));
+            quadros++;
             
-            // Quadradinho piscando no canto quando tem alerta
-            if (local.alerta_ativo) {
-                static bool pisca = false;
-                pisca = !pisca;
-                if (pisca) {
-                    ssd1306_draw_square(&display, 120, 0, 8, 8);
-                }
+            if (paginas) {
+                ssd1306_show(&display);
+                quadros_enviados++;
             }
-            
-            // No rodapé mostra quantas tasks o FreeRTOS tá gerenciando
-            snprintf(buffer, sizeof(buffer), "Tasks: %lu", 
-                     (unsigned long)uxTaskGetNumberOfTasks());
-            ssd1306_draw_string(&display, 0, 56, 1, buffer);
-            
-            ssd1306_show(&display);
             xSemaphoreGive(mutex_i2c1);
+        } else {
+            printf("[DISPLAY] I2C1 ocupado, quadro fica pro proximo\n");
+        }
+        
+        // A cada ~10s mostra quantos quadros precisaram ir pro I2C e quanto cada um custou
+        if (xTaskGetTickCount() - ultimo_relatorio >= pdMS_TO_TICKS(10000)) {
+            ultimo_relatorio = xTaskGetTickCount();
+            printf("[DISPLAY] Quadros: %lu, enviados: %lu, bytes ultimo=%lu medio=%lu (quadro cheio=%u)\n",
+                   (unsigned long)quadros, (unsigned long)quadros_enviados,
+                   (unsigned long)display.last_show_bytes,
+                   (unsigned long)(display.show_count ? display.show_bytes_total / display.show_count : 0),
+                   (unsigned)(display.bufsize + 1));
         }
         
-        vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(PERIODO_DISPLAY_MS));
+        // Durante o alerta atualiza mais rápido (o ângulo muda e a equipe tá olhando)
+        vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(local.alerta_ativo ? PERIODO_DISPLAY_ALERTA_MS
+                                                                          : PERIODO_DISPLAY_MS));
     }
 }
 
+/**
+ * Task de envio do display — manda o buffer da frente pro OLED
+ * 
+ * Dorme até a task_display trocar os buffers. Com DMA, só monta o
+ * stream e espera a interrupção; sem DMA, faz o envio bloqueante aqui
+ * mesmo, sem atrasar o desenho do próximo quadro.
+ */
+static void task_display_tx(void *pvParameters) {
+    (void)pvParameters;
+    
+    printf("[TASK_DISPLAY_TX] Iniciada (prioridade=%lu)\n", 
+           (unsigned long)uxTaskPriorityGet(NULL));
+    
+    for (;;) {
+        ulTaskNotifyTakeIndexed(NOTIFICACAO_QUADRO, pdTRUE, portMAX_DELAY);
+        
+        if (xSemaphoreTake(mutex_i2c1, pdMS_TO_TICKS(100)) != pdTRUE) {
+            printf("[DISPLAY_TX] I2C1 ocupado, quadro fica pro proximo\n");
+            continue;
+        }
+        
+        // O DMA manda o quadro pelo I2C1 e a task dorme até a interrupção avisar
+        if (ssd1306_show_async(&display) &&
+            ulTaskNotifyTakeIndexed(NOTIFICACAO_DMA, pdTRUE, pdMS_TO_TICKS(100)) == 0) {
+            printf("[DISPLAY_TX] Transferencia DMA nao terminou em 100ms\n");
+        }
+        xSemaphoreGive(mutex_i2c1);
+    }
+}
+
+// Publica a mudança de alerta que a task dos sensores deixou pendente. Ela só
+// sai de vez com o PUBACK: timeout ou queda da conexão antes disso rearmam o
+// alerta (a não ser que já tenha chegado uma mudança mais nova).
+// Devolve false se ainda tem alerta esperando pra ir pro lwIP (sem conexão,
+// buffer cheio ou o anterior ainda esperando o PUBACK)
+static bool publicar_alerta_pendente(void) {
+    if (alerta_mqtt_em_voo) {
+        mqtt_alerta_resultado_t resultado = mqtt_verificar_alerta();
+        if (resultado == MQTT_ALERTA_CONFIRMADO) {
+            alerta_mqtt_em_voo = false;
+            alerta_mqtt_latencia_ultima_us = time_us_32() - alerta_mqtt_em_voo_instante_us;
+            if (alerta_mqtt_latencia_ultima_us > alerta_mqtt_latencia_max_us) {
+                alerta_mqtt_latencia_max_us = alerta_mqtt_latencia_ultima_us;
+            }
+            alerta_mqtt_eventos++;
+        } else if (resultado == MQTT_ALERTA_FALHOU) {
+            alerta_mqtt_em_voo = false;
+            taskENTER_CRITICAL();
+            if (!alerta_mqtt_pendente) {
+                alerta_mqtt_ativo = alerta_mqtt_em_voo_ativo;
+                alerta_mqtt_instante_us = alerta_mqtt_em_voo_instante_us;
+                alerta_mqtt_pendente = true;
+            }
+            taskEXIT_CRITICAL();
+            printf("[MQTT] Alerta sem PUBACK, reenviando\n");
+        }
+    }
+    
+    if (!alerta_mqtt_pendente) return true;
+    if (alerta_mqtt_em_voo || !mqtt_esta_conectado()) return false;
+    
+    taskENTER_CRITICAL();
+    bool ativo = alerta_mqtt_ativo;
+    uint32_t instante_us = alerta_mqtt_instante_us;
+    alerta_mqtt_pendente = false;
+    taskEXIT_CRITICAL();
+    
+    if (mqtt_publicar_alerta(ativo) != ERR_OK) {
+        // Continua pendente (se nesse meio tempo chegou outra mudança, já está lá)
+        alerta_mqtt_pendente = true;
+        return false;
+    }
+    
+    alerta_mqtt_em_voo = true;
+    alerta_mqtt_em_voo_ativo = ativo;
+    alerta_mqtt_em_voo_instante_us = instante_us;
+    return true;
+}
+
 /**
  * Task do MQTT — publica dados a cada 5 segundos
  * 
- * Manda temperatura, umidade, ângulo e status de alerta pro broker.
- * Se perdeu a conexão, tenta reconectar automaticamente antes de publicar.
+ * O registro do ciclo só entra na fila_mqtt se passar no filtro de
+ * report-by-exception: algum canal saiu da banda morta, o alerta mudou ou o
+ * heartbeat venceu. Isso vale com ou sem rede. Conectado, a task drena a
+ * fila em lotes (os mais antigos primeiro), então uma queda do WiFi não abre
+ * buraco no gráfico: os registros chegam depois com o instante em que foram
+ * medidos.
+ * A conexão com o broker é a máquina de estados do mqtt_module: a task roda
+ * mqtt_executar() a cada vez que acorda (período, evento de rede ou o prazo
+ * que a própria máquina pediu), então reconectar nunca trava a amostragem.
+ * Uma mudança do alerta acorda a task na hora e sai em TOPIC_ALERTA antes
+ * de qualquer lote de telemetria; ela é reenviada até o broker confirmar.
  */
 static void task_mqtt(void *pvParameters) {
     (void)pvParameters;
@@ -407,70 +668,133 @@ static void task_mqtt(void *pvParameters) {
     printf("[TASK_MQTT] Iniciada (prioridade=%lu)\n", 
            (unsigned long)uxTaskPriorityGet(NULL));
     
-    TickType_t xLastWakeTime = xTaskGetTickCount();
+    TickType_t proximo_ciclo = xTaskGetTickCount();
+    uint16_t sequencia = 0;
+    uint32_t descartados_antes = 0;
+    bool conectado_antes = mqtt_esta_conectado();
+    dados_sistema_t local;
+    
+    telemetria_fila_init(&fila_mqtt);
+    telemetria_filtro_init(&filtro_mqtt);
+    mqtt_set_aviso(mqtt_evento_rede);
     
     for (;;) {
-        dados_sistema_t local;
-        dados_sistema_ler(&local);
-        
-        if (local.wifi_conectado) {
-            cyw43_arch_poll();
+        // Chegou a hora do ciclo: a amostra só vira registro se mudou o bastante
+        // (ou o heartbeat venceu); sem broker ela espera na fila. A sequência só
+        // conta o que foi pra fila
+        bool ciclo = (int32_t)(xTaskGetTickCount() - proximo_ciclo) >= 0;
+        if (ciclo) {
+            dados_sistema_ler(&local);
             
-            // Se caiu a conexão com o broker, tenta reconectar
-            if (!mqtt_esta_conectado()) {
-                printf("[MQTT] Tentando reconectar ao broker...\n");
-                conectar_mqtt();
-                
-                // Fica fazendo polling até conectar (ou até estourar o limite)
-                for (int i = 0; i < 30; i++) {
-                    cyw43_arch_poll();
-                    vTaskDelay(pdMS_TO_TICKS(100));
-                    if (mqtt_esta_conectado()) break;
-                }
+            telemetria_t registro;
+            telemetria_montar(&registro, sequencia, local.instante_ms,
+                              local.temperatura, local.umidade, local.angulo_x,
+                              local.alerta_ativo, local.dados_validos);
+            if (telemetria_filtro_avaliar(&filtro_mqtt, &registro, (uint32_t)(time_us_64() / 1000))) {
+                telemetria_fila_inserir(&fila_mqtt, &registro);
+                sequencia++;
             }
             
-            // Se tá conectado, manda todos os dados pros tópicos
-            if (mqtt_esta_conectado()) {
-                char msg[16];
-                
-                // Temperatura
-                snprintf(msg, sizeof(msg), "%.1f", local.temperatura);
-                mqtt_publish_message(TOPIC_TEMPERATURA, msg);
-                cyw43_arch_poll();
-                vTaskDelay(pdMS_TO_TICKS(100));
-                
-                // Umidade
-                snprintf(msg, sizeof(msg), "%.1f", local.umidade);
-                mqtt_publish_message(TOPIC_UMIDADE, msg);
-                cyw43_arch_poll();
-                vTaskDelay(pdMS_TO_TICKS(100));
-                
-                // Ângulo
-                snprintf(msg, sizeof(msg), "%.1f", local.angulo_x);
-                mqtt_publish_message(TOPIC_ANGULO, msg);
-                cyw43_arch_poll();
-                vTaskDelay(pdMS_TO_TICKS(100));
+            proximo_ciclo += pdMS_TO_TICKS(PERIODO_MQTT_MS);
+            if ((int32_t)(xTaskGetTickCount() - proximo_ciclo) >= 0) {
+                // Ficou mais de um período pra trás: não adianta recuperar os ciclos perdidos
+                proximo_ciclo = xTaskGetTickCount() + pdMS_TO_TICKS(PERIODO_MQTT_MS);
+            }
+        }
+        
+        // Anda a conexão (DNS, CONNACK, backoff) sem bloquear
+        cyw43_arch_poll();
+        uint32_t espera_conexao_ms = mqtt_executar();
+        
+        // O alerta vai primeiro, antes de encher o buffer do lwIP com lotes
+        publicar_alerta_pendente();
+        
+        // Se tá conectado, drena a fila em lotes QoS 1. Quem dita o ritmo é o
+        // broker: com a janela cheia (ou o lwIP sem espaço) a task dorme até o
+        // próximo PUBACK acordar ela. O que não sair no prazo fica pro próximo ciclo
+        if (mqtt_esta_conectado() &&
+            (telemetria_fila_profundidade(&fila_mqtt) > mqtt_registros_em_voo(&fila_mqtt) ||
+             mqtt_lotes_em_voo() > 0)) {
+            TickType_t inicio_drenagem = xTaskGetTickCount();
+            int lotes = 0;
+            uint32_t confirmados = 0;
+            
+            for (;;) {
+                confirmados += mqtt_confirmar_lotes(&fila_mqtt);
                 
-                // Alerta
-                mqtt_publish_message(TOPIC_ALERTA, local.alerta_ativo ? "ATIVO" : "OK");
-                cyw43_arch_poll();
-                vTaskDelay(pdMS_TO_TICKS(100));
+                // Alerta que chegou no meio da drenagem passa na frente; enquanto
+                // ele não sair, nenhum lote novo entra no buffer
+                bool alerta_saiu = publicar_alerta_pendente();
+                bool falta_publicar = telemetria_fila_profundidade(&fila_mqtt) >
+                                      mqtt_registros_em_voo(&fila_mqtt);
+                if (alerta_saiu && falta_publicar && lotes < MQTT_LOTES_POR_CICLO) {
+                    int n = mqtt_publicar_lote(&fila_mqtt);
+                    if (n > 0) {
+                        lotes++;
+                        continue;
+                    }
+                    if (n < 0) break;
+                } else if (alerta_saiu && mqtt_lotes_em_voo() == 0) {
+                    break;      // Tudo publicado e confirmado
+                }
                 
-                // Status
-                mqtt_publish_message(TOPIC_STATUS, "online");
+                if (!mqtt_esta_conectado() ||
+                    xTaskGetTickCount() - inicio_drenagem >= pdMS_TO_TICKS(MQTT_DRENAGEM_MAX_MS)) {
+                    break;
+                }
                 cyw43_arch_poll();
-                
-                printf("[MQTT] Dados publicados: T=%.1f U=%.1f A=%.1f alerta=%s\n",
-                       local.temperatura, local.umidade, local.angulo_x,
-                       local.alerta_ativo ? "SIM" : "NAO");
+                ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(PERIODO_MQTT_ESPERA_MS));
             }
             
-            // Atualiza o status de rede na struct global
-            dados_sistema_atualizar_conectividade(
-                wifi_esta_conectado(), mqtt_esta_conectado());
+            if (confirmados > 0) {
+                printf("[MQTT] Dados publicados: T=%.1f U=%.1f A=%.1f (%.1f/s) alerta=%s, %lu registros confirmados (%d lotes)\n",
+                       local.temperatura, local.umidade, local.angulo_x, local.taxa_angular,
+                       local.alerta_ativo ? "SIM" : "NAO", (unsigned long)confirmados, lotes);
+            }
         }
         
-        vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(PERIODO_MQTT_MS));
+        // Atualiza o status de rede na struct global (a cada ciclo ou quando o broker muda)
+        bool conectado = mqtt_esta_conectado();
+        if (ciclo || conectado != conectado_antes) {
+            dados_sistema_atualizar_conectividade(wifi_esta_conectado(), conectado);
+            conectado_antes = conectado;
+        }
+        
+        if (ciclo) {
+            MQTT_STATE_T *estado = mqtt_get_state();
+            
+            // Fila acumulando (ou perdendo registros): mostra o tamanho
+            uint32_t profundidade = telemetria_fila_profundidade(&fila_mqtt);
+            if (profundidade > 1 || fila_mqtt.descartados != descartados_antes) {
+                printf("[MQTT] Fila: %lu registros (max %lu de %u), %lu descartados, %lu lotes em voo, %lu/%lu lotes confirmados, %lu falhas\n",
+                       (unsigned long)profundidade, (unsigned long)fila_mqtt.profundidade_max,
+                       (unsigned)TELEMETRIA_FILA_TAMANHO, (unsigned long)fila_mqtt.descartados,
+                       (unsigned long)mqtt_lotes_em_voo(), (unsigned long)estado->lotes_confirmados,
+                       (unsigned long)estado->lotes_enviados, (unsigned long)estado->lotes_falhos);
+                descartados_antes = fila_mqtt.descartados;
+            }
+            
+            // Quanto o report-by-exception está economizando
+            if ((filtro_mqtt.aprovados + filtro_mqtt.suprimidos) % 60 == 0) {
+                printf("[MQTT] Filtro: %lu registros enviados, %lu suprimidos\n",
+                       (unsigned long)filtro_mqtt.aprovados, (unsigned long)filtro_mqtt.suprimidos);
+                printf("[MQTT] Conexao: %lu tentativas, %lu falhas, %lu consultas DNS, %lu conexoes, tempo ultimo/max: %lu/%lu ms\n",
+                       (unsigned long)estado->tentativas, (unsigned long)estado->falhas,
+                       (unsigned long)estado->consultas_dns, (unsigned long)estado->conexoes,
+                       (unsigned long)estado->tempo_conexao_ms, (unsigned long)estado->tempo_conexao_max_ms);
+            }
+        }
+        
+        // Dorme até o próximo ciclo, até o prazo da máquina de conexão ou até um evento de rede
+        TickType_t agora = xTaskGetTickCount();
+        TickType_t espera = ((int32_t)(proximo_ciclo - agora) > 0) ? proximo_ciclo - agora : 0;
+        if (espera_conexao_ms > 0 && pdMS_TO_TICKS(espera_conexao_ms) < espera) {
+            espera = pdMS_TO_TICKS(espera_conexao_ms);
+        }
+        if (alerta_mqtt_pendente && mqtt_esta_conectado() && pdMS_TO_TICKS(PERIODO_MQTT_ESPERA_MS) < espera) {
+            espera = pdMS_TO_TICKS(PERIODO_MQTT_ESPERA_MS);     // Alerta esperando espaço no lwIP
+        }
+        ulTaskNotifyTake(pdTRUE, espera);
     }
 }
 
@@ -487,6 +811,7 @@ static void task_uart(void *pvParameters) {
            (unsigned long)uxTaskPriorityGet(NULL));
     
     TickType_t xLastWakeTime = xTaskGetTickCount();
+    uint16_t sequencia = 0;
     
     for (;;) {
         dados_sistema_t local;
@@ -494,12 +819,11 @@ static void task_uart(void *pvParameters) {
         
         // Só transmite se o usuário ativou pelo botão
         if (uart_transmissao_esta_ativa()) {
-            uart_esp_enviar_dados(
-                local.temperatura, 
-                local.umidade, 
-                local.angulo_x, 
-                local.alerta_ativo
-            );
+            telemetria_t registro;
+            telemetria_montar(&registro, sequencia++, local.instante_ms,
+                              local.temperatura, local.umidade, local.angulo_x,
+                              local.alerta_ativo, local.dados_validos);
+            uart_esp_enviar_telemetria(&registro);
         }
         
         vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(PERIODO_UART_MS));
@@ -526,15 +850,26 @@ static void task_wifi_monitor(void *pvParameters) {
             bool reconectou = conectar_wifi();
             if (reconectou) {
                 mqtt_set_wifi_conectado(true);
+                conectar_mqtt();    // Rede nova: tenta o broker já, sem esperar o backoff
                 printf("[WIFI_MONITOR] WiFi reconectado! IP: %s\n", obter_ip_local());
             } else {
                 mqtt_set_wifi_conectado(false);
                 printf("[WIFI_MONITOR] Falha na reconexão WiFi\n");
             }
+            xTaskNotifyGive(handle_task_mqtt);
             
             dados_sistema_atualizar_conectividade(reconectou, mqtt_esta_conectado());
         }
         
+        printf("[ALERTAS] Mudancas: %lu, latencia amostra->LED ultima/max: %lu/%lu us\n",
+               (unsigned long)alerta_eventos, (unsigned long)alerta_latencia_ultima_us,
+               (unsigned long)alerta_latencia_max_us);
+        printf("[ALERTAS] MQTT: %lu confirmados, %lu reenvios, latencia amostra->PUBACK ultima/max: %lu/%lu us\n",
+               (unsigned long)alerta_mqtt_eventos, (unsigned long)mqtt_get_state()->alertas_falhos,
+               (unsigned long)alerta_mqtt_latencia_ultima_us, (unsigned long)alerta_mqtt_latencia_max_us);
+        printf("[DADOS] Leituras: %lu, releituras por escrita concorrente: %lu\n",
+               (unsigned long)dados_leituras, (unsigned long)dados_releituras);
+        
         vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(PERIODO_WIFI_MONITOR_MS));
     }
 }
@@ -573,16 +908,15 @@ static void inicializar_hardware(void) {
     printf("[INIT] Inicializando OLED...\n");
     if (!ssd1306_init(&display, OLED_WIDTH, OLED_HEIGHT, OLED_ADDR, i2c1)) {
         printf("[ERRO] Falha ao inicializar display OLED!\n");
+    } else if (!ssd1306_dma_init(&display, display_transferencia_concluida, NULL)) {
+        printf("[INIT] OLED sem DMA (usando envio bloqueante)\n");
     }
     sleep_ms(100);
     
-    // Mostra uma tela de boas-vindas enquanto o sistema carrega
-    ssd1306_clear(&display);
-    ssd1306_draw_string(&display, 10, 10, 2, "HOSPITAL");
-    ssd1306_draw_line(&display, 0, 35, 127, 35);
-    ssd1306_draw_string(&display, 5, 40, 1, "FreeRTOS Test Init...");
+    // Mostra a tela de boas-vindas (assets/splash.bmp, já no formato do OLED)
+    // e segue carregando; ela fica na tela até o "Conectando WiFi..."
+    ssd1306_blit(&display, 0, 0, &imagem_splash);
     ssd1306_show(&display);
-    sleep_ms(1500);
     
     printf("[INIT] Hardware inicializado com sucesso\n");
 }
@@ -611,15 +945,18 @@ static bool inicializar_rede(void) {
         ssd1306_draw_string(&display, 5, 40, 1, "Conectando MQTT...");
         ssd1306_show(&display);
         
-        // Agora tenta o MQTT
+        // Agora tenta o MQTT (a máquina de conexão anda a cada passo; se não
+        // der em 5 s, a task_mqtt continua tentando com backoff)
         conectar_mqtt();
         for (int i = 0; i < 50; i++) {
             cyw43_arch_poll();
-            sleep_ms(100);
+            mqtt_executar();
             if (mqtt_esta_conectado()) {
-                printf("[INIT] MQTT conectado após %d ms\n", i * 100);
+                printf("[INIT] MQTT conectado após %lu ms\n",
+                       (unsigned long)mqtt_get_state()->tempo_conexao_ms);
                 break;
             }
+            sleep_ms(100);
         }
         
         if (mqtt_esta_conectado()) {
@@ -646,22 +983,21 @@ static bool inicializar_rede(void) {
     return wifi_ok;
 }
 
-// Cria os 3 mutexes que protegem os recursos compartilhados
+// Cria os 2 mutexes que protegem os barramentos (os dados usam o seqlock)
 static bool criar_mutexes(void) {
     mutex_i2c0 = xSemaphoreCreateMutex();
     mutex_i2c1 = xSemaphoreCreateMutex();
-    mutex_dados = xSemaphoreCreateMutex();
     
-    if (!mutex_i2c0 || !mutex_i2c1 || !mutex_dados) {
+    if (!mutex_i2c0 || !mutex_i2c1) {
         printf("[ERRO] Falha ao criar mutexes!\n");
         return false;
     }
     
-    printf("[INIT] Mutexes criados (I2C0, I2C1, Dados)\n");
+    printf("[INIT] Mutexes criados (I2C0, I2C1)\n");
     return true;
 }
 
-// Registra as 6 tasks no FreeRTOS com suas prioridades e tamanhos de pilha
+// Registra as 7 tasks (6 sem o segundo buffer do display) no FreeRTOS com suas prioridades e tamanhos de pilha
 static bool criar_tasks(void) {
     BaseType_t ret;
     
@@ -681,7 +1017,20 @@ static bool criar_tasks(void) {
         return false;
     }
     
-    // Display: atualiza a tela OLED
+    // Display: desenha a tela OLED num buffer enquanto o outro vai pelo I2C.
+    // Sem o segundo buffer a task_display faz o envio ela mesma
+    display_buffer_duplo = ssd1306_double_buffer_init(&display);
+    if (display_buffer_duplo) {
+        ret = xTaskCreate(task_display_tx, "DisplayTx", STACK_SIZE_DISPLAY_TX,
+                          NULL, TASK_PRIORITY_DISPLAY_TX, &handle_task_display_tx);
+        if (ret != pdPASS) {
+            printf("[ERRO] Falha ao criar task_display_tx\n");
+            return false;
+        }
+    } else {
+        printf("[INIT] OLED com um buffer so (desenho e envio juntos no mutex do I2C1)\n");
+    }
+    
     ret = xTaskCreate(task_display, "Display", STACK_SIZE_DISPLAY,
                       NULL, TASK_PRIORITY_DISPLAY, &handle_task_display);
     if (ret != pdPASS) {
@@ -689,6 +1038,14 @@ static bool criar_tasks(void) {
         return false;
     }
     
+#if DISPLAY_NO_CORE1
+    // Núcleo 0 fica com WiFi/MQTT e sensores; o display inteiro vai pro 1
+    vTaskCoreAffinitySet(handle_task_display, 1 << 1);
+    if (handle_task_display_tx) {
+        vTaskCoreAffinitySet(handle_task_display_tx, 1 << 1);
+    }
+#endif
+    
     // MQTT: publica dados no broker
     ret = xTaskCreate(task_mqtt, "MQTT", STACK_SIZE_MQTT,
                       NULL, TASK_PRIORITY_MQTT, &handle_task_mqtt);
@@ -713,10 +1070,12 @@ static bool criar_tasks(void) {
         return false;
     }
     
-    printf("[INIT] Todas as 6 tasks criadas com sucesso\n");
+    printf("[INIT] Todas as %d tasks criadas com sucesso\n", display_buffer_duplo ? 7 : 6);
     printf("  - Sensores:    prio=%d stack=%d\n", TASK_PRIORITY_SENSORES, STACK_SIZE_SENSORES);
     printf("  - Alertas:     prio=%d stack=%d\n", TASK_PRIORITY_ALERTAS, STACK_SIZE_ALERTAS);
     printf("  - Display:     prio=%d stack=%d\n", TASK_PRIORITY_DISPLAY, STACK_SIZE_DISPLAY);
+    printf("  - DisplayTx:   prio=%d stack=%d%s\n", TASK_PRIORITY_DISPLAY_TX, STACK_SIZE_DISPLAY_TX,
+           DISPLAY_NO_CORE1 ? " (display no core 1)" : "");
     printf("  - MQTT:        prio=%d stack=%d\n", TASK_PRIORITY_MQTT, STACK_SIZE_MQTT);
     printf("  - UART:        prio=%d stack=%d\n", TASK_PRIORITY_UART, STACK_SIZE_UART);
     printf("  - WiFi Monitor:prio=%d stack=%d\n", TASK_PRIORITY_WIFI_MONITOR, STACK_SIZE_WIFI_MONITOR);
@@ -730,6 +1089,21 @@ int main(void) {
     // Primeiro liga tudo (I2C, display, pinos, UART...)
     inicializar_hardware();
     
+    // Expande a chave AES uma vez (cada mensagem MQTT só recarrega o IV)
+    security_init();
+    
+#ifdef PROJETO_BENCHMARK
+    // Mede os caminhos críticos antes de o scheduler entrar em cena
+    bool bench_ok = benchmark_executar_todos();
+#ifdef PROJETO_HOST_BUILD
+    // No host o build de benchmark só mede e sai, com as verificações no código
+    // de saída (no CI quem roda é o projeto_testes_host, pelo ctest)
+    return bench_ok ? 0 : 1;
+#else
+    (void)bench_ok;
+#endif
+#endif
+    
     // Cria os mutexes antes de qualquer coisa que use recursos compartilhados
     if (!criar_mutexes()) {
         printf("[FATAL] Nao foi possivel criar mutexes. Sistema parado.\n");
@@ -67,6 +67,7 @@
 #define configUSE_NEWLIB_REENTRANT 0
 #define configENABLE_BACKWARD_COMPATIBILITY 0
 #define configNUM_THREAD_LOCAL_STORAGE_POINTERS 5
+#define configTASK_NOTIFICATION_ARRAY_ENTRIES 2
 
 /* System */
 #define configSTACK_DEPTH_TYPE uint32_t
@@ -110,6 +111,11 @@
 #define configTICK_CORE 0
 #define configRUN_MULTIPLE_PRIORITIES 1
 #define configUSE_CORE_AFFINITY 0
+/* -DPROJETO_DISPLAY_CORE1=ON no CMake prende as tasks do display no núcleo 1 */
+#ifdef PROJETO_DISPLAY_CORE1
+#undef configUSE_CORE_AFFINITY
+#define configUSE_CORE_AFFINITY 1
+#endif
 
 /* RP2040 specific */
 #define configSUPPORT_PICO_SYNC_INTEROP 1
@@ -138,6 +144,27 @@ to exclude the API function. */
 #define INCLUDE_xTaskResumeFromISR 1
 #define INCLUDE_xQueueGetMutexHolder 1
 
+/* Build host (Linux): a porta POSIX é single-core e cada task vira uma pthread */
+#ifdef PROJETO_HOST_BUILD
+#undef configNUM_CORES
+#define configNUM_CORES 1
+#undef configRUN_MULTIPLE_PRIORITIES
+#define configRUN_MULTIPLE_PRIORITIES 0
+#undef configUSE_CORE_AFFINITY
+#define configUSE_CORE_AFFINITY 0
+#undef configSUPPORT_PICO_SYNC_INTEROP
+#define configSUPPORT_PICO_SYNC_INTEROP 0
+#undef configSUPPORT_PICO_TIME_INTEROP
+#define configSUPPORT_PICO_TIME_INTEROP 0
+#undef configTOTAL_HEAP_SIZE
+#define configTOTAL_HEAP_SIZE (4 * 1024 * 1024)
+#undef configMINIMAL_STACK_SIZE
+#define configMINIMAL_STACK_SIZE (configSTACK_DEPTH_TYPE)(PTHREAD_STACK_MIN / sizeof(StackType_t))
+#undef configTIMER_TASK_STACK_DEPTH
+#define configTIMER_TASK_STACK_DEPTH configMINIMAL_STACK_SIZE
+#include <limits.h>
+#endif
+
 /* A header file that defines trace macro can be included here. */
 
-#endif /* FREERTOS_CONFIG_H */
\ No newline at end of file
+#endif /* FREERTOS_CONFIG_H */
\ No newline at end of file
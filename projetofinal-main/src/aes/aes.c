@@ -25,6 +25,9 @@ ECB-AES128
     7b0c785e27e8ad3f8223207104725dd4 
 
 
+AES_TTABLES=1 swaps the byte-oriented rounds for word-oriented ones using
+precomputed T-tables (see aes.h); both must produce the vectors above.
+
 NOTE:   String length must be evenly divisible by 16byte (str_len % 16 == 0)
         You should pad the end of the string with zeros if this is not the case.
         For AES192/256 the key size is proportionally larger.
@@ -62,6 +65,20 @@ NOTE:   String length must be evenly divisible by 16byte (str_len % 16 == 0)
   #define MULTIPLY_AS_A_FUNCTION 0
 #endif
 
+#if AES_TTABLES
+  #if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    #error "AES_TTABLES reads the round keys as little-endian words"
+  #endif
+
+  // On the RP2040 the T-table rounds run from RAM, so a block never waits on an XIP cache miss.
+  #if defined(PICO_ON_DEVICE) && PICO_ON_DEVICE
+    #include "pico/platform.h"
+    #define AES_RAM_FUNC(f) __not_in_flash_func(f)
+  #else
+    #define AES_RAM_FUNC(f) f
+  #endif
+#endif
+
 
 
 
@@ -216,14 +233,24 @@ static void KeyExpansion(uint8_t* RoundKey, const uint8_t* Key)
   }
 }
 
+#if AES_TTABLES
+static void PrepareWordRounds(struct AES_ctx* ctx);
+#endif
+
 void AES_init_ctx(struct AES_ctx* ctx, const uint8_t* key)
 {
   KeyExpansion(ctx->RoundKey, key);
+#if AES_TTABLES
+  PrepareWordRounds(ctx);
+#endif
 }
 #if (defined(CBC) && (CBC == 1)) || (defined(CTR) && (CTR == 1))
 void AES_init_ctx_iv(struct AES_ctx* ctx, const uint8_t* key, const uint8_t* iv)
 {
   KeyExpansion(ctx->RoundKey, key);
+#if AES_TTABLES
+  PrepareWordRounds(ctx);
+#endif
   memcpy (ctx->Iv, iv, AES_BLOCKLEN);
 }
 void AES_ctx_set_iv(struct AES_ctx* ctx, const uint8_t* iv)
@@ -232,6 +259,7 @@ void AES_ctx_set_iv(struct AES_ctx* ctx, const uint8_t* iv)
 }
 #endif
 
+#if !AES_TTABLES
 // This function adds the round key to state.
 // The round key is added to the state by an XOR function.
 static void AddRoundKey(uint8_t round, state_t* state, const uint8_t* RoundKey)
@@ -290,12 +318,14 @@ static void ShiftRows(state_t* state)
   (*state)[2][3] = (*state)[1][3];
   (*state)[1][3] = temp;
 }
+#endif // #if !AES_TTABLES
 
 static uint8_t xtime(uint8_t x)
 {
   return ((x<<1) ^ (((x>>7) & 1) * 0x1b));
 }
 
+#if !AES_TTABLES
 // MixColumns function mixes the columns of the state matrix
 static void MixColumns(state_t* state)
 {
@@ -311,6 +341,7 @@ static void MixColumns(state_t* state)
     Tm  = (*state)[i][3] ^ t ;              Tm = xtime(Tm);  (*state)[i][3] ^= Tm ^ Tmp ;
   }
 }
+#endif // #if !AES_TTABLES
 
 // Multiply is used to multiply numbers in the field GF(2^8)
 // Note: The last call to xtime() is unneeded, but often ends up generating a smaller binary
@@ -344,6 +375,7 @@ static uint8_t getSBoxInvert(uint8_t num)
 */
 #define getSBoxInvert(num) (rsbox[(num)])
 
+#if !AES_TTABLES
 // MixColumns function mixes the columns of the state matrix.
 // The method used to multiply may be difficult to understand for the inexperienced.
 // Please use the references to gain more information.
@@ -407,11 +439,173 @@ static void InvShiftRows(state_t* state)
   (*state)[2][3] = (*state)[3][3];
   (*state)[3][3] = temp;
 }
+#endif // #if !AES_TTABLES
+#endif // #if (defined(CBC) && CBC == 1) || (defined(ECB) && ECB == 1)
+
+#if AES_TTABLES
+/*****************************************************************************/
+/* Word-oriented rounds (T-tables):                                          */
+/*****************************************************************************/
+// A column is one little-endian word, row 0 in the low byte. Te[x] is the
+// MixColumns output for S(x) entering at row 0 ({02}S, S, S, {03}S); the same
+// byte entering at rows 1..3 gives Te[x] rotated left by 8, 16 and 24 bits, so
+// one 1 KB table per direction covers SubBytes, ShiftRows and MixColumns.
+// The tables are built from sbox/rsbox by the first AES_init_ctx*(); being
+// zero-initialised data they live in RAM, not in XIP flash.
+static uint32_t Te[256];
+#if (defined(CBC) && CBC == 1) || (defined(ECB) && ECB == 1)
+static uint32_t Td[256];      // InvMixColumns output for InvS(x) at row 0: {0e}, {09}, {0d}, {0b}
+static uint8_t InvSbox[256];  // RAM copy of rsbox for the last decryption round
+#endif
+static uint8_t TablesReady = 0;
+
+#define ROTL8(x)     (((x) << 8) | ((x) >> 24))
+#define ROTL16(x)    (((x) << 16) | ((x) >> 16))
+#define ROTL24(x)    (((x) << 24) | ((x) >> 8))
+#define BYTE(x, n)   ((uint8_t)((x) >> (8 * (n))))
+
+static void BuildTables(void)
+{
+  unsigned i;
+  for (i = 0; i < 256; ++i)
+  {
+    uint8_t s = getSBoxValue(i);
+    uint8_t s2 = xtime(s);
+    Te[i] = (uint32_t)s2 | ((uint32_t)s << 8) | ((uint32_t)s << 16) | ((uint32_t)(s2 ^ s) << 24);
+#if (defined(CBC) && CBC == 1) || (defined(ECB) && ECB == 1)
+    uint8_t v = getSBoxInvert(i);
+    Td[i] = (uint32_t)Multiply(v, 0x0e) | ((uint32_t)Multiply(v, 0x09) << 8) |
+            ((uint32_t)Multiply(v, 0x0d) << 16) | ((uint32_t)Multiply(v, 0x0b) << 24);
+    InvSbox[i] = v;
+#endif
+  }
+  TablesReady = 1;
+}
+
+// Builds the tables on first use and, for decryption, the round keys of the
+// equivalent inverse cipher: InvMixColumns applied to round keys 1..Nr-1.
+static void PrepareWordRounds(struct AES_ctx* ctx)
+{
+  if (!TablesReady)
+  {
+    BuildTables();
+  }
+#if (defined(CBC) && CBC == 1) || (defined(ECB) && ECB == 1)
+  unsigned i;
+  for (i = 0; i < Nb * (Nr + 1); ++i)
+  {
+    uint32_t w = ctx->RoundKeyW[i];
+    if (i < Nb || i >= Nb * Nr)
+    {
+      ctx->InvRoundKeyW[i] = w;
+    }
+    else
+    {
+      // Td[S(x)] is InvMixColumns of x alone at row 0
+      ctx->InvRoundKeyW[i] = Td[getSBoxValue(BYTE(w, 0))] ^ ROTL8(Td[getSBoxValue(BYTE(w, 1))]) ^
+                             ROTL16(Td[getSBoxValue(BYTE(w, 2))]) ^ ROTL24(Td[getSBoxValue(BYTE(w, 3))]);
+    }
+  }
+#else
+  (void)ctx;
+#endif
+}
+
+static uint32_t LoadColumn(const uint8_t* p)
+{
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void StoreColumn(uint8_t* p, uint32_t w)
+{
+  p[0] = BYTE(w, 0);
+  p[1] = BYTE(w, 1);
+  p[2] = BYTE(w, 2);
+  p[3] = BYTE(w, 3);
+}
+
+// One full round for output column: rows 0..3 come from columns a, b, c, d.
+#define TE_COLUMN(a, b, c, d) \
+  (Te[BYTE(a, 0)] ^ ROTL8(Te[BYTE(b, 1)]) ^ ROTL16(Te[BYTE(c, 2)]) ^ ROTL24(Te[BYTE(d, 3)]))
+// Last round (no MixColumns): S(x) is byte 1 of Te[x].
+#define SB_COLUMN(a, b, c, d) \
+  ((uint32_t)BYTE(Te[BYTE(a, 0)], 1) | ((uint32_t)BYTE(Te[BYTE(b, 1)], 1) << 8) | \
+   ((uint32_t)BYTE(Te[BYTE(c, 2)], 1) << 16) | ((uint32_t)BYTE(Te[BYTE(d, 3)], 1) << 24))
+
+static void AES_RAM_FUNC(Cipher)(state_t* state, const struct AES_ctx* ctx)
+{
+  uint8_t* buf = (uint8_t*)state;
+  const uint32_t* rk = ctx->RoundKeyW;
+  uint32_t s0, s1, s2, s3, t0, t1, t2, t3;
+  uint8_t round;
+
+  s0 = LoadColumn(buf + 0)  ^ rk[0];
+  s1 = LoadColumn(buf + 4)  ^ rk[1];
+  s2 = LoadColumn(buf + 8)  ^ rk[2];
+  s3 = LoadColumn(buf + 12) ^ rk[3];
+
+  // ShiftRows moves row r of column j+r into column j
+  for (round = 1; round < Nr; ++round)
+  {
+    rk += Nb;
+    t0 = TE_COLUMN(s0, s1, s2, s3) ^ rk[0];
+    t1 = TE_COLUMN(s1, s2, s3, s0) ^ rk[1];
+    t2 = TE_COLUMN(s2, s3, s0, s1) ^ rk[2];
+    t3 = TE_COLUMN(s3, s0, s1, s2) ^ rk[3];
+    s0 = t0; s1 = t1; s2 = t2; s3 = t3;
+  }
+
+  rk += Nb;
+  StoreColumn(buf + 0,  SB_COLUMN(s0, s1, s2, s3) ^ rk[0]);
+  StoreColumn(buf + 4,  SB_COLUMN(s1, s2, s3, s0) ^ rk[1]);
+  StoreColumn(buf + 8,  SB_COLUMN(s2, s3, s0, s1) ^ rk[2]);
+  StoreColumn(buf + 12, SB_COLUMN(s3, s0, s1, s2) ^ rk[3]);
+}
+
+#if (defined(CBC) && CBC == 1) || (defined(ECB) && ECB == 1)
+#define TD_COLUMN(a, b, c, d) \
+  (Td[BYTE(a, 0)] ^ ROTL8(Td[BYTE(b, 1)]) ^ ROTL16(Td[BYTE(c, 2)]) ^ ROTL24(Td[BYTE(d, 3)]))
+#define ISB_COLUMN(a, b, c, d) \
+  ((uint32_t)InvSbox[BYTE(a, 0)] | ((uint32_t)InvSbox[BYTE(b, 1)] << 8) | \
+   ((uint32_t)InvSbox[BYTE(c, 2)] << 16) | ((uint32_t)InvSbox[BYTE(d, 3)] << 24))
+
+static void AES_RAM_FUNC(InvCipher)(state_t* state, const struct AES_ctx* ctx)
+{
+  uint8_t* buf = (uint8_t*)state;
+  const uint32_t* rk = ctx->InvRoundKeyW + Nb * Nr;
+  uint32_t s0, s1, s2, s3, t0, t1, t2, t3;
+  uint8_t round;
+
+  s0 = LoadColumn(buf + 0)  ^ rk[0];
+  s1 = LoadColumn(buf + 4)  ^ rk[1];
+  s2 = LoadColumn(buf + 8)  ^ rk[2];
+  s3 = LoadColumn(buf + 12) ^ rk[3];
+
+  // InvShiftRows moves row r of column j-r into column j
+  for (round = Nr - 1; round > 0; --round)
+  {
+    rk -= Nb;
+    t0 = TD_COLUMN(s0, s3, s2, s1) ^ rk[0];
+    t1 = TD_COLUMN(s1, s0, s3, s2) ^ rk[1];
+    t2 = TD_COLUMN(s2, s1, s0, s3) ^ rk[2];
+    t3 = TD_COLUMN(s3, s2, s1, s0) ^ rk[3];
+    s0 = t0; s1 = t1; s2 = t2; s3 = t3;
+  }
+
+  rk -= Nb;
+  StoreColumn(buf + 0,  ISB_COLUMN(s0, s3, s2, s1) ^ rk[0]);
+  StoreColumn(buf + 4,  ISB_COLUMN(s1, s0, s3, s2) ^ rk[1]);
+  StoreColumn(buf + 8,  ISB_COLUMN(s2, s1, s0, s3) ^ rk[2]);
+  StoreColumn(buf + 12, ISB_COLUMN(s3, s2, s1, s0) ^ rk[3]);
+}
 #endif // #if (defined(CBC) && CBC == 1) || (defined(ECB) && ECB == 1)
 
+#else // AES_TTABLES
+
 // Cipher is the main function that encrypts the PlainText.
-static void Cipher(state_t* state, const uint8_t* RoundKey)
+static void Cipher(state_t* state, const struct AES_ctx* ctx)
 {
+  const uint8_t* RoundKey = ctx->RoundKey;
   uint8_t round = 0;
 
   // Add the First round key to the state before starting the rounds.
@@ -436,8 +630,9 @@ static void Cipher(state_t* state, const uint8_t* RoundKey)
 }
 
 #if (defined(CBC) && CBC == 1) || (defined(ECB) && ECB == 1)
-static void InvCipher(state_t* state, const uint8_t* RoundKey)
+static void InvCipher(state_t* state, const struct AES_ctx* ctx)
 {
+  const uint8_t* RoundKey = ctx->RoundKey;
   uint8_t round = 0;
 
   // Add the First round key to the state before starting the rounds.
@@ -461,6 +656,8 @@ static void InvCipher(state_t* state, const uint8_t* RoundKey)
 }
 #endif // #if (defined(CBC) && CBC == 1) || (defined(ECB) && ECB == 1)
 
+#endif // AES_TTABLES
+
 /*****************************************************************************/
 /* Public functions:                                                         */
 /*****************************************************************************/
@@ -470,13 +667,13 @@ static void InvCipher(state_t* state, const uint8_t* RoundKey)
 void AES_ECB_encrypt(const struct AES_ctx* ctx, uint8_t* buf)
 {
   // The next function call encrypts the PlainText with the Key using AES algorithm.
-  Cipher((state_t*)buf, ctx->RoundKey);
+  Cipher((state_t*)buf, ctx);
 }
 
 void AES_ECB_decrypt(const struct AES_ctx* ctx, uint8_t* buf)
 {
   // The next function call decrypts the PlainText with the Key using AES algorithm.
-  InvCipher((state_t*)buf, ctx->RoundKey);
+  InvCipher((state_t*)buf, ctx);
 }
 
 
@@ -505,7 +702,7 @@ void AES_CBC_encrypt_buffer(struct AES_ctx *ctx, uint8_t* buf, size_t length)
   for (i = 0; i < length; i += AES_BLOCKLEN)
   {
     XorWithIv(buf, Iv);
-    Cipher((state_t*)buf, ctx->RoundKey);
+    Cipher((state_t*)buf, ctx);
     Iv = buf;
     buf += AES_BLOCKLEN;
   }
@@ -520,7 +717,7 @@ void AES_CBC_decrypt_buffer(struct AES_ctx* ctx, uint8_t* buf, size_t length)
   for (i = 0; i < length; i += AES_BLOCKLEN)
   {
     memcpy(storeNextIv, buf, AES_BLOCKLEN);
-    InvCipher((state_t*)buf, ctx->RoundKey);
+    InvCipher((state_t*)buf, ctx);
     XorWithIv(buf, ctx->Iv);
     memcpy(ctx->Iv, storeNextIv, AES_BLOCKLEN);
     buf += AES_BLOCKLEN;
@@ -547,7 +744,7 @@ void AES_CTR_xcrypt_buffer(struct AES_ctx* ctx, uint8_t* buf, size_t length)
     {
       
       memcpy(buffer, ctx->Iv, AES_BLOCKLEN);
-      Cipher((state_t*)buffer,ctx->RoundKey);
+      Cipher((state_t*)buffer, ctx);
 
       /* Increment Iv and handle overflow */
       for (bi = (AES_BLOCKLEN - 1); bi >= 0; --bi)
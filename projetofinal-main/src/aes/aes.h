@@ -23,6 +23,13 @@
   #define CTR 1
 #endif
 
+// AES_TTABLES=1 uses word-oriented rounds with precomputed T-tables (2 KB of
+// tables in RAM, plus the decryption round keys in each context) instead of
+// the byte-oriented SubBytes/ShiftRows/MixColumns. Same API and results.
+#ifndef AES_TTABLES
+  #define AES_TTABLES 0
+#endif
+
 
 #define AES128 1
 //#define AES192 1
@@ -43,7 +50,19 @@
 
 struct AES_ctx
 {
+#if AES_TTABLES
+  // Word access for the T-table rounds (one little-endian word per column)
+  union
+  {
+    uint8_t RoundKey[AES_keyExpSize];
+    uint32_t RoundKeyW[AES_keyExpSize / 4];
+  };
+#if (defined(CBC) && (CBC == 1)) || (defined(ECB) && (ECB == 1))
+  uint32_t InvRoundKeyW[AES_keyExpSize / 4];  // Equivalent inverse cipher round keys
+#endif
+#else
   uint8_t RoundKey[AES_keyExpSize];
+#endif
 #if (defined(CBC) && (CBC == 1)) || (defined(CTR) && (CTR == 1))
   uint8_t Iv[AES_BLOCKLEN];
 #endif
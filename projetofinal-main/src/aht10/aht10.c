@@ -1,5 +1,11 @@
 #include "aht10.h"
 
+#if AHT10_USAR_CRC
+#define AHT10_BYTES_LEITURA 7
+#else
+#define AHT10_BYTES_LEITURA 6
+#endif
+
 void aht10_i2c_init(){
     i2c_init(i2c0, 400 * 1000); // 400kHz
     gpio_set_function(AHT10_I2C_SDA_PIN, GPIO_FUNC_I2C);
@@ -8,37 +14,84 @@ void aht10_i2c_init(){
     gpio_pull_up(AHT10_I2C_SCL_PIN);
 }
 
+void aht10_soft_reset() {
+    uint8_t cmd = 0xBA;
+    i2c_write_blocking(AHT10_I2C_PORT, AHT10_ADDR, &cmd, 1, false);
+}
+
 void aht10_init() {
-    // Esta linha prepara o comando de inicialização para o AHT10
-    uint8_t cmd[] = {0xBE, 0x08, 0x00};
+    // Comando de inicialização/calibração do AHT10
+    // Sem sleep aqui: quem chama espera com vTaskDelay e não trava o escalonador
+    uint8_t cmd[] = {0xE1, 0x08, 0x00};
     i2c_write_blocking(AHT10_I2C_PORT, AHT10_ADDR, cmd, 3, false);
-    sleep_ms(50); // aumente o tempo de espera para garantir a inicialização
 }
 
-void aht10_trigger_measurement() {
+#if AHT10_USAR_CRC
+// CRC-8 do AHT20: polinômio 0x31, valor inicial 0xFF
+static uint8_t aht10_crc8(const uint8_t *dados, int len) {
+    uint8_t crc = 0xFF;
+    for (int i = 0; i < len; i++) {
+        crc ^= dados[i];
+        for (int b = 0; b < 8; b++) {
+            crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x31) : (uint8_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+#endif
+
+bool aht10_iniciar_medicao(aht10_t *aht, uint32_t agora_us) {
     // Esta linha prepara o comando para iniciar uma medição no AHT10
     uint8_t cmd[] = {0xAC, 0x33, 0x00};
-    i2c_write_blocking(AHT10_I2C_PORT, AHT10_ADDR, cmd, 3, false);
-    sleep_ms(80); // tempo de espera da medição
+    if (i2c_write_blocking(AHT10_I2C_PORT, AHT10_ADDR, cmd, 3, false) != 3) {
+        aht->estado = AHT10_ERRO;
+        return false;
+    }
+    aht->inicio_us = agora_us;
+    aht->estado = AHT10_CONVERTENDO;
+    return true;
 }
 
-bool aht10_read(float *temperature, float *humidity) {
-    // Esta linha lê 6 bytes de dados do sensor AHT10 via I2C e armazena no array 'data'
-    uint8_t data[6];
-    int res = i2c_read_blocking(AHT10_I2C_PORT, AHT10_ADDR, data, 6, false);
-    if (res != 6) return false;
+aht10_estado_t aht10_poll(aht10_t *aht, uint32_t agora_us) {
+    if (aht->estado != AHT10_CONVERTENDO) return aht->estado;
 
-    // Checa se o sensor ainda está ocupado (bit 7 do primeiro byte)
-    if (data[0] & 0x80) {
-        // Sensor ainda está processando, leitura inválida
-        return false;
+    uint32_t decorrido = agora_us - aht->inicio_us;
+    if (decorrido < AHT10_TEMPO_MIN_US) return aht->estado;
+
+    // Status e dados vêm na mesma leitura
+    uint8_t data[AHT10_BYTES_LEITURA];
+    int res = i2c_read_blocking(AHT10_I2C_PORT, AHT10_ADDR, data, AHT10_BYTES_LEITURA, false);
+    if (res != AHT10_BYTES_LEITURA) {
+        aht->estado = AHT10_ERRO;
+        return aht->estado;
     }
+    aht->status = data[0];
+
+    if (data[0] & AHT10_STATUS_OCUPADO) {
+        if (decorrido > AHT10_TIMEOUT_US) aht->estado = AHT10_ERRO;
+        return aht->estado;
+    }
+
+    // Sem calibração os valores não valem nada (precisa de aht10_init de novo)
+    if (!(data[0] & AHT10_STATUS_CALIBRADO)) {
+        aht->estado = AHT10_ERRO;
+        return aht->estado;
+    }
+
+#if AHT10_USAR_CRC
+    if (aht10_crc8(data, 6) != data[6]) {
+        aht->estado = AHT10_ERRO;
+        return aht->estado;
+    }
+#endif
 
     uint32_t hum_raw = ((uint32_t)data[1] << 12) | ((uint32_t)data[2] << 4) | ((data[3] >> 4) & 0x0F);
     uint32_t temp_raw = (((uint32_t)data[3] & 0x0F) << 16) | ((uint32_t)data[4] << 8) | data[5];
 
     // Cálculo conforme datasheet do AHT10
-    *humidity = ((float)hum_raw / 1048576.0f) * 100.0f;
-    *temperature = ((float)temp_raw / 1048576.0f) * 200.0f - 50.0f;
-    return true;
+    aht->umidade = ((float)hum_raw / 1048576.0f) * 100.0f;
+    aht->temperatura = ((float)temp_raw / 1048576.0f) * 200.0f - 50.0f;
+    // Entrega o resultado uma vez e já fica livre pra próxima medição
+    aht->estado = AHT10_OCIOSO;
+    return AHT10_PRONTO;
 }
@@ -9,9 +9,52 @@
 #define AHT10_I2C_SDA_PIN 0
 #define AHT10_I2C_SCL_PIN 1
 
+// Bits do byte de status
+#define AHT10_STATUS_OCUPADO    0x80    // Conversão em andamento
+#define AHT10_STATUS_CALIBRADO  0x08    // Coeficientes de calibração carregados
+
+// Tempos da medição (datasheet: ~75ms típico)
+#define AHT10_TEMPO_MIN_US      40000   // Nem adianta consultar o status antes disso
+#define AHT10_TIMEOUT_US        200000  // Desiste da conversão depois disso
+
+// AHT20/AHT21 mandam um 7º byte com CRC-8 (polinômio 0x31); o AHT10 não
+#ifndef AHT10_USAR_CRC
+#define AHT10_USAR_CRC 0
+#endif
+
+// Máquina de estados da medição assíncrona
+typedef enum {
+    AHT10_OCIOSO,       // Nenhuma medição em andamento
+    AHT10_CONVERTENDO,  // Medição disparada, esperando o bit de ocupado cair
+    AHT10_PRONTO,       // Medição nova em temperatura/umidade (só como retorno do poll)
+    AHT10_ERRO          // Falha de I2C, CRC, calibração ou timeout
+} aht10_estado_t;
+
+typedef struct {
+    aht10_estado_t estado;
+    uint32_t inicio_us;     // Quando a medição foi disparada
+    uint8_t status;         // Último byte de status lido
+    float temperatura;
+    float umidade;
+} aht10_t;
+
 void aht10_i2c_init();
-void aht10_init();
-void aht10_trigger_measurement();
-bool aht10_read(float *temperature, float *humidity);
+void aht10_soft_reset();    // Depois dele, esperar 20ms antes do aht10_init()
+void aht10_init();          // Depois dele, esperar 10ms antes da primeira medição
+
+/**
+ * @brief Dispara uma medição sem esperar (estado vai pra AHT10_CONVERTENDO)
+ * @return false se o comando não foi aceito no I2C
+ */
+bool aht10_iniciar_medicao(aht10_t *aht, uint32_t agora_us);
+
+/**
+ * @brief Avança a máquina de estados; chamar periodicamente com o I2C0 livre
+ *
+ * Enquanto converte, cada chamada faz uma única leitura do sensor: se o bit
+ * de ocupado já caiu, os mesmos bytes já trazem o resultado.
+ * @return AHT10_PRONTO uma única vez por medição; senão, o estado atual
+ */
+aht10_estado_t aht10_poll(aht10_t *aht, uint32_t agora_us);
 
-#endif // AHT10_H
\ No newline at end of file
+#endif // AHT10_H
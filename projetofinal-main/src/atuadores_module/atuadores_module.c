@@ -34,6 +34,10 @@ bool angulo_na_faixa(float angulo) {
     return (angulo >= ANGULO_MIN && angulo <= ANGULO_MAX);
 }
 
+bool angulo_decimos_na_faixa(int16_t decimos) {
+    return (decimos >= (int16_t)(ANGULO_MIN * 10) && decimos <= (int16_t)(ANGULO_MAX * 10));
+}
+
 uint calcular_angulo_servo(float angulo_atual) {
     float diferenca = ANGULO_ALVO - angulo_atual;
     
@@ -43,6 +43,13 @@ void buzzer_toggle(void);
  */
 bool angulo_na_faixa(float angulo);
 
+/**
+ * @brief Mesma verificação, com o ângulo em décimos de grau (sem float)
+ * @param decimos Ângulo atual em décimos de grau
+ * @return true se está na faixa (300-450), false caso contrário
+ */
+bool angulo_decimos_na_faixa(int16_t decimos);
+
 /**
  * @brief Calcula o ângulo do servo para corrigir a posição
  * @param angulo_atual Ângulo atual da cama
@@ -0,0 +1,587 @@
+/**
+ * @file benchmark_module.c
+ * @brief Implementação dos micro-benchmarks
+ */
+
+#include "benchmark_module.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "pico/stdlib.h"
+#include "hardware/clocks.h"
+#include "mpu6050.h"
+#include "ssd1306.h"
+#include "display_module/display_module.h"
+#include "telemetria_module/telemetria_module.h"
+#include "security_module/security_module.h"
+#include "aes/aes.h"
+#ifdef PROJETO_HOST_BUILD
+#include "host_hal.h"
+
+// O CMake aponta pro host/golden/ do projeto e pro diretório do build; sem ele,
+// relativos ao diretório atual
+#ifndef PROJETO_GOLDEN_DIR
+#define PROJETO_GOLDEN_DIR "host/golden"
+#endif
+#ifndef PROJETO_CAPTURAS_DIR
+#define PROJETO_CAPTURAS_DIR "."
+#endif
+#endif
+
+// Definida no ssd1306.c (o font.h não pode ser incluído em dois arquivos)
+extern const uint8_t font_8x5[];
+
+// ==================== CONFIGURAÇÕES ====================
+#define BENCH_ITERACOES      20000
+#define BENCH_AMOSTRAS       256
+#define BENCH_QUADROS        200
+#define BENCH_CRIPTOGRAFIAS  1000
+#define BENCH_AES_BYTES      64      // Os 4 blocos dos vetores do NIST
+
+// Impede o compilador de jogar fora o resultado das chamadas medidas
+static volatile int32_t sumidouro;
+
+// ==================== AUXILIARES ====================
+
+uint32_t benchmark_ciclos_por_iteracao(uint64_t us, uint32_t iteracoes) {
+    uint64_t ciclos = us * (clock_get_hz(clk_sys) / 1000000u);
+    return (uint32_t)(ciclos / iteracoes);
+}
+
+// ==================== INCLINAÇÃO ====================
+
+void benchmark_inclinacao(void) {
+    static int16_t ax[BENCH_AMOSTRAS], ay[BENCH_AMOSTRAS], az[BENCH_AMOSTRAS];
+
+    // Entradas variadas: ângulos espalhados na faixa toda, com 1g de módulo
+    for (int i = 0; i < BENCH_AMOSTRAS; i++) {
+        double th = (i * 180.0 / BENCH_AMOSTRAS - 90.0) * M_PI / 180.0;
+        ax[i] = (int16_t)(16384.0 * sin(th));
+        ay[i] = (int16_t)(16384.0 * cos(th) * 0.3);
+        az[i] = (int16_t)(16384.0 * cos(th) * 0.95);
+    }
+
+    uint64_t t0 = time_us_64();
+    for (int i = 0; i < BENCH_ITERACOES; i++) {
+        int k = i & (BENCH_AMOSTRAS - 1);
+        sumidouro = (int32_t)mpu6050_get_inclination(ax[k], ay[k], az[k]);
+    }
+    uint64_t t_float = time_us_64() - t0;
+
+    t0 = time_us_64();
+    for (int i = 0; i < BENCH_ITERACOES; i++) {
+        int k = i & (BENCH_AMOSTRAS - 1);
+        sumidouro = mpu6050_get_inclination_tenths(ax[k], ay[k], az[k]);
+    }
+    uint64_t t_fixo = time_us_64() - t0;
+
+    // Precisão: varre -90.0° .. +90.0° e compara com o float
+    float erro_max = 0, erro_soma = 0;
+    int pontos = 0;
+    for (int d = -900; d <= 900; d++) {
+        double th = d * M_PI / 1800.0;
+        int16_t x = (int16_t)(16384.0 * sin(th));
+        int16_t z = (int16_t)(16384.0 * cos(th));
+        float ref = mpu6050_get_inclination(x, 0, z) * 10.0f;
+        float erro = fabsf((float)mpu6050_get_inclination_tenths(x, 0, z) - ref);
+        if (erro > erro_max) erro_max = erro;
+        erro_soma += erro;
+        pontos++;
+    }
+
+    printf("[BENCH] Inclinacao float: %lu ciclos/chamada\n",
+           (unsigned long)benchmark_ciclos_por_iteracao(t_float, BENCH_ITERACOES));
+    printf("[BENCH] Inclinacao CORDIC: %lu ciclos/chamada\n",
+           (unsigned long)benchmark_ciclos_por_iteracao(t_fixo, BENCH_ITERACOES));
+    printf("[BENCH] Erro CORDIC x float: max=%.3f medio=%.3f decimos de grau\n",
+           erro_max, erro_soma / pontos);
+}
+
+// ==================== DISPLAY ====================
+
+// Framebuffer só na RAM (o benchmark não manda nada pro OLED)
+static uint8_t bench_fb[128 * 64 / 8];
+static ssd1306_t bench_display = {
+    .width = 128, .height = 64, .pages = 8, .buffer = bench_fb, .bufsize = sizeof(bench_fb)
+};
+
+// Textos que a task_display escreve a cada quadro
+static const struct {
+    uint8_t x, y;
+    const char *texto;
+} bench_tela[] = {
+    {0, 0, "CAMA HOSPITALAR"}, {90, 0, "W"}, {100, 0, "M"}, {115, 0, "F"},
+    {0, 14, "Angulo: 37.5"}, {0, 24, "OK (30-45)"},
+    {0, 38, "Temp: 25.0 C"}, {0, 48, "Umid: 55.0 %"}, {0, 56, "Tasks: 7"},
+};
+
+// Como o driver desenhava antes: um quadrado scale x scale por pixel aceso
+static void bench_char_pixel_a_pixel(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t scale, char c) {
+    if (c < font_8x5[3] || c > font_8x5[4]) return;
+    for (uint8_t w = 0; w < font_8x5[1]; w++) {
+        uint8_t linha = font_8x5[5 + (c - font_8x5[3]) * font_8x5[1] + w];
+        for (int j = 0; j < 8; j++, linha >>= 1) {
+            if (!(linha & 1)) continue;
+            for (uint32_t i = 0; i < scale; i++)
+                for (uint32_t k = 0; k < scale; k++)
+                    ssd1306_draw_pixel(p, x + w * scale + i, y + j * scale + k);
+        }
+    }
+}
+
+static void bench_tela_pixel_a_pixel(uint32_t scale) {
+    for (size_t t = 0; t < sizeof(bench_tela) / sizeof(bench_tela[0]); t++) {
+        uint32_t x = bench_tela[t].x;
+        for (const char *c = bench_tela[t].texto; *c; c++, x += (font_8x5[1] + font_8x5[2]) * scale) {
+            bench_char_pixel_a_pixel(&bench_display, x, bench_tela[t].y, scale, *c);
+        }
+    }
+}
+
+static void bench_tela_colunas(uint32_t scale) {
+    for (size_t t = 0; t < sizeof(bench_tela) / sizeof(bench_tela[0]); t++) {
+        ssd1306_draw_string(&bench_display, bench_tela[t].x, bench_tela[t].y, scale, bench_tela[t].texto);
+    }
+}
+
+void benchmark_display_texto(void) {
+    static uint8_t referencia[sizeof(bench_fb)];
+
+    for (uint32_t scale = 1; scale <= 2; scale++) {
+        uint64_t t0 = time_us_64();
+        for (int i = 0; i < BENCH_QUADROS; i++) {
+            ssd1306_clear(&bench_display);
+            bench_tela_pixel_a_pixel(scale);
+        }
+        uint64_t t_pixel = time_us_64() - t0;
+        memcpy(referencia, bench_fb, sizeof(bench_fb));
+
+        t0 = time_us_64();
+        for (int i = 0; i < BENCH_QUADROS; i++) {
+            ssd1306_clear(&bench_display);
+            bench_tela_colunas(scale);
+        }
+        uint64_t t_colunas = time_us_64() - t0;
+
+        printf("[BENCH] Textos da tela (escala %lu): pixel a pixel %lu ciclos, colunas %lu ciclos%s\n",
+               (unsigned long)scale,
+               (unsigned long)benchmark_ciclos_por_iteracao(t_pixel, BENCH_QUADROS),
+               (unsigned long)benchmark_ciclos_por_iteracao(t_colunas, BENCH_QUADROS),
+               memcmp(referencia, bench_fb, sizeof(bench_fb)) == 0 ? "" : " (IMAGEM DIFERENTE!)");
+    }
+}
+
+// Reta como o driver fazia: inclinação em float, um pixel por coluna
+static void bench_reta_float(ssd1306_t *p, int32_t x1, int32_t y1, int32_t x2, int32_t y2) {
+    float m = (float)(y2 - y1) / (float)(x2 - x1);
+    for (int32_t i = x1; i <= x2; i++) {
+        float y = m * (float)(i - x1) + (float)y1;
+        ssd1306_draw_pixel(p, i, (uint32_t)y);
+    }
+}
+
+static void bench_quadrado_pixel_a_pixel(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t w, uint32_t h) {
+    for (uint32_t i = 0; i < w; i++)
+        for (uint32_t j = 0; j < h; j++)
+            ssd1306_draw_pixel(p, x + i, y + j);
+}
+
+void benchmark_display_formas(void) {
+    static uint8_t referencia[sizeof(bench_fb)];
+
+    // Separadores e o quadradinho que pisca no canto (o que a task_display redesenha todo quadro)
+    uint64_t t0 = time_us_64();
+    for (int i = 0; i < BENCH_QUADROS; i++) {
+        ssd1306_clear(&bench_display);
+        bench_reta_float(&bench_display, 0, 10, 127, 10);
+        bench_reta_float(&bench_display, 0, 34, 127, 34);
+        bench_quadrado_pixel_a_pixel(&bench_display, 120, 0, 8, 8);
+    }
+    uint64_t t_antes = time_us_64() - t0;
+    memcpy(referencia, bench_fb, sizeof(bench_fb));
+
+    t0 = time_us_64();
+    for (int i = 0; i < BENCH_QUADROS; i++) {
+        ssd1306_clear(&bench_display);
+        ssd1306_draw_line(&bench_display, 0, 10, 127, 10);
+        ssd1306_draw_line(&bench_display, 0, 34, 127, 34);
+        ssd1306_draw_square(&bench_display, 120, 0, 8, 8);
+    }
+    uint64_t t_depois = time_us_64() - t0;
+
+    printf("[BENCH] Linhas + quadrado: float/pixel %lu ciclos, spans/paginas %lu ciclos%s\n",
+           (unsigned long)benchmark_ciclos_por_iteracao(t_antes, BENCH_QUADROS),
+           (unsigned long)benchmark_ciclos_por_iteracao(t_depois, BENCH_QUADROS),
+           memcmp(referencia, bench_fb, sizeof(bench_fb)) == 0 ? "" : " (IMAGEM DIFERENTE!)");
+
+    // Reta íngreme: a versão float deixa buracos (um pixel por coluna)
+    ssd1306_clear(&bench_display);
+    bench_reta_float(&bench_display, 10, 0, 20, 63);
+    int pixels_float = 0;
+    for (size_t i = 0; i < sizeof(bench_fb); i++) pixels_float += __builtin_popcount(bench_fb[i]);
+    ssd1306_clear(&bench_display);
+    ssd1306_draw_line(&bench_display, 10, 0, 20, 63);
+    int pixels_bresenham = 0;
+    for (size_t i = 0; i < sizeof(bench_fb); i++) pixels_bresenham += __builtin_popcount(bench_fb[i]);
+    printf("[BENCH] Reta (10,0)-(20,63): float acende %d pixels, Bresenham %d\n",
+           pixels_float, pixels_bresenham);
+}
+
+// ==================== TELA PRINCIPAL ====================
+
+// Os estados que a task_display mostra (valores em décimos)
+static const struct {
+    const char *nome;
+    display_valores_t valores;
+} bench_estados[] = {
+    {"normal",       {375, 250, 550, true,  false, true,  true,  7}},
+    {"alerta_alto",  {512, 250, 550, true,  true,  true,  true,  7}},
+    {"alerta_baixo", {215, 250, 550, true,  true,  true,  true,  7}},
+    {"lendo",        {0,   0,   0,   false, false, true,  true,  7}},
+    {"offline",      {375, 250, 550, true,  false, false, false, 7}},
+};
+
+bool benchmark_display_tela_principal(void) {
+    bool ok = true;
+
+    for (size_t e = 0; e < sizeof(bench_estados) / sizeof(bench_estados[0]); e++) {
+        const display_valores_t *v = &bench_estados[e].valores;
+
+        // Tela inteira do zero: limpa o buffer e desenha todos os widgets
+        uint64_t t0 = time_us_64();
+        for (int i = 0; i < BENCH_QUADROS; i++) {
+            display_tela_principal_init(&bench_display);
+            display_tela_principal_atualizar(v, 0);
+        }
+        uint64_t t_cheia = time_us_64() - t0;
+
+        // Quadro típico: só o ângulo mudou uma casa
+        display_valores_t mudou = *v;
+        t0 = time_us_64();
+        for (int i = 0; i < BENCH_QUADROS; i++) {
+            mudou.angulo_decimos = (int16_t)(v->angulo_decimos + (i & 1));
+            display_tela_principal_atualizar(&mudou, 0);
+        }
+        uint64_t t_parcial = time_us_64() - t0;
+
+        printf("[BENCH] Tela %-12s: cheia %lu ciclos (%lu quadros/s), so o angulo %lu ciclos\n",
+               bench_estados[e].nome,
+               (unsigned long)benchmark_ciclos_por_iteracao(t_cheia, BENCH_QUADROS),
+               (unsigned long)(t_cheia ? 1000000ull * BENCH_QUADROS / t_cheia : 0),
+               (unsigned long)benchmark_ciclos_por_iteracao(t_parcial, BENCH_QUADROS));
+    }
+
+#ifdef PROJETO_HOST_BUILD
+    // Manda cada tela pro OLED de captura (0x3D) pelo caminho de verdade
+    // (ssd1306_show -> I2C simulado -> GDDRAM), salva o que chegou lá e
+    // confere com a imagem de referência
+    ssd1306_t captura = {0};
+    if (!ssd1306_init(&captura, 128, 64, 0x3D, i2c1)) {
+        printf("[BENCH] Falha ao iniciar o OLED de captura\n");
+        return false;
+    }
+    const char *atualizar = getenv("PROJETO_HOST_GOLDEN_ATUALIZAR");
+    bool regravar = atualizar && atualizar[0] == '1';
+
+    for (size_t e = 0; e < sizeof(bench_estados) / sizeof(bench_estados[0]); e++) {
+        char nome[32], caminho[256], referencia[256];
+        snprintf(nome, sizeof(nome), "tela_%s.pbm", bench_estados[e].nome);
+        snprintf(caminho, sizeof(caminho), "%s/%s", PROJETO_CAPTURAS_DIR, nome);
+        snprintf(referencia, sizeof(referencia), "%s/%s", PROJETO_GOLDEN_DIR, nome);
+        display_tela_principal_init(&captura);
+        display_tela_principal_atualizar(&bench_estados[e].valores, 0);
+        ssd1306_show(&captura);
+        bool igual = memcmp(host_ssd1306_gddram(0x3D), captura.buffer, captura.bufsize) == 0;
+        printf("[BENCH] %s%s\n", host_ssd1306_salvar_pbm(0x3D, caminho) ? caminho : "(falha ao salvar PBM)",
+               igual ? "" : " (GDDRAM DIFERENTE DO BUFFER!)");
+
+        if (regravar) {
+            bool salvo = host_ssd1306_salvar_pbm(0x3D, referencia);
+            printf("[BENCH] %s %s\n", salvo ? "Referência regravada:" : "FALHA ao regravar", referencia);
+            ok = ok && salvo && igual;
+        } else if (!host_ssd1306_comparar_pbm(0x3D, referencia)) {
+            printf("[BENCH] FALHA: %s difere de %s\n", caminho, referencia);
+            ok = false;
+        } else {
+            ok = ok && igual;
+        }
+    }
+    ssd1306_deinit(&captura);
+#endif
+    return ok;
+}
+
+// ==================== TELEMETRIA ====================
+
+// Leituras variadas (°C, %, graus) pra não medir sempre o mesmo caminho do printf
+static void bench_leitura(int i, float *t, float *u, float *a) {
+    *t = 18.0f + (i % 170) * 0.1f;
+    *u = 30.0f + (i % 600) * 0.1f;
+    *a = -20.0f + (i % 900) * 0.1f;
+}
+
+void benchmark_telemetria(void) {
+    char texto[64];
+    uint8_t binario[TELEMETRIA_TAMANHO];
+    telemetria_t registro;
+    size_t bytes_texto = 0;
+    float t, u, a;
+
+    // Codificação: a linha "%.1f,%.1f,%.1f,%d" que ia pra UART x registro binário
+    uint64_t t0 = time_us_64();
+    for (int i = 0; i < BENCH_ITERACOES; i++) {
+        bench_leitura(i, &t, &u, &a);
+        bytes_texto += (size_t)snprintf(texto, sizeof(texto), "%.1f,%.1f,%.1f,%d\n", t, u, a, i & 1);
+    }
+    uint64_t t_cod_texto = time_us_64() - t0;
+
+    t0 = time_us_64();
+    for (int i = 0; i < BENCH_ITERACOES; i++) {
+        bench_leitura(i, &t, &u, &a);
+        telemetria_montar(&registro, (uint16_t)i, (uint32_t)i, t, u, a, i & 1, true);
+        sumidouro = (int32_t)telemetria_codificar(&registro, binario);
+    }
+    uint64_t t_cod_bin = time_us_64() - t0;
+
+    // Decodificação: o que o receptor faz com cada formato
+    snprintf(texto, sizeof(texto), "%.1f,%.1f,%.1f,%d\n", 25.3f, 61.7f, 37.5f, 0);
+    t0 = time_us_64();
+    for (int i = 0; i < BENCH_ITERACOES; i++) {
+        char *p = texto;
+        float tt = strtof(p, &p);
+        float uu = strtof(p + 1, &p);
+        float aa = strtof(p + 1, &p);
+        long al = strtol(p + 1, NULL, 10);
+        sumidouro = (int32_t)(tt + uu + aa) + (int32_t)al;
+    }
+    uint64_t t_dec_texto = time_us_64() - t0;
+
+    t0 = time_us_64();
+    for (int i = 0; i < BENCH_ITERACOES; i++) {
+        sumidouro = telemetria_decodificar(binario, sizeof(binario), &registro) ? registro.angulo : -1;
+    }
+    uint64_t t_dec_bin = time_us_64() - t0;
+
+    // Criptografia do payload MQTT: o JSON da versão anterior x o registro binário
+    uint8_t cifrado[128];
+    size_t len_json = 0, len_bin = 0;
+    snprintf(texto, sizeof(texto), "{\"t\":%.1f,\"u\":%.1f,\"a\":%.1f,\"al\":%d}", 25.3f, 61.7f, 37.5f, 0);
+    t0 = time_us_64();
+    for (int i = 0; i < BENCH_CRIPTOGRAFIAS; i++) {
+        security_encrypt_message(texto, cifrado, &len_json);
+    }
+    uint64_t t_aes_json = time_us_64() - t0;
+
+    t0 = time_us_64();
+    for (int i = 0; i < BENCH_CRIPTOGRAFIAS; i++) {
+        security_encrypt_buffer(binario, sizeof(binario), cifrado, &len_bin);
+    }
+    uint64_t t_aes_bin = time_us_64() - t0;
+
+    printf("[BENCH] Telemetria texto: %u bytes medios, codifica %lu ciclos, decodifica %lu ciclos\n",
+           (unsigned)(bytes_texto / BENCH_ITERACOES),
+           (unsigned long)benchmark_ciclos_por_iteracao(t_cod_texto, BENCH_ITERACOES),
+           (unsigned long)benchmark_ciclos_por_iteracao(t_dec_texto, BENCH_ITERACOES));
+    printf("[BENCH] Telemetria binaria: %u bytes, codifica %lu ciclos, decodifica %lu ciclos\n",
+           (unsigned)TELEMETRIA_TAMANHO,
+           (unsigned long)benchmark_ciclos_por_iteracao(t_cod_bin, BENCH_ITERACOES),
+           (unsigned long)benchmark_ciclos_por_iteracao(t_dec_bin, BENCH_ITERACOES));
+    printf("[BENCH] AES do payload MQTT: JSON %u bytes cifrados %lu ciclos, binario %u bytes cifrados %lu ciclos\n",
+           (unsigned)len_json, (unsigned long)benchmark_ciclos_por_iteracao(t_aes_json, BENCH_CRIPTOGRAFIAS),
+           (unsigned)len_bin, (unsigned long)benchmark_ciclos_por_iteracao(t_aes_bin, BENCH_CRIPTOGRAFIAS));
+}
+
+// ==================== CRIPTOGRAFIA ====================
+
+// Chave/IV só pra medir: o custo do AES não depende do valor
+static const uint8_t bench_chave[AES_KEYLEN] = "chave-benchmark";
+static const uint8_t bench_iv[AES_BLOCKLEN] = "iv-do-benchmark";
+
+// Como o security_encrypt_buffer era: expande a chave a cada mensagem
+static void bench_cifrar_expandindo(const uint8_t *dados, size_t len, uint8_t *saida) {
+    struct AES_ctx ctx;
+    AES_init_ctx_iv(&ctx, bench_chave, bench_iv);
+
+    size_t total = (len / AES_BLOCKLEN + 1) * AES_BLOCKLEN;
+    memcpy(saida, dados, len);
+    memset(saida + len, (int)(total - len), total - len);
+    AES_CBC_encrypt_buffer(&ctx, saida, total);
+}
+
+// Como o security_decrypt_message era
+static void bench_decifrar_expandindo(const uint8_t *cifrado, size_t len, uint8_t *saida) {
+    struct AES_ctx ctx;
+    AES_init_ctx_iv(&ctx, bench_chave, bench_iv);
+
+    memcpy(saida, cifrado, len);
+    AES_CBC_decrypt_buffer(&ctx, saida, len);
+}
+
+void benchmark_criptografia(void) {
+    static const size_t tamanhos[] = { TELEMETRIA_TAMANHO, 8 * TELEMETRIA_TAMANHO };
+    uint8_t claro[128], cifrado[128], decifrado[129];
+    struct AES_ctx ctx;
+
+    for (size_t i = 0; i < sizeof(claro); i++) {
+        claro[i] = (uint8_t)(i * 7 + 1);
+    }
+
+    // Só a expansão da chave: o que cada mensagem deixou de pagar
+    uint64_t t0 = time_us_64();
+    for (int i = 0; i < BENCH_CRIPTOGRAFIAS; i++) {
+        AES_init_ctx(&ctx, bench_chave);
+    }
+    uint64_t t_expansao = time_us_64() - t0;
+    printf("[BENCH] AES KeyExpansion: %lu ciclos\n",
+           (unsigned long)benchmark_ciclos_por_iteracao(t_expansao, BENCH_CRIPTOGRAFIAS));
+
+    for (size_t k = 0; k < sizeof(tamanhos) / sizeof(tamanhos[0]); k++) {
+        size_t len = tamanhos[k];
+        size_t len_cifrado = 0;
+
+        t0 = time_us_64();
+        for (int i = 0; i < BENCH_CRIPTOGRAFIAS; i++) {
+            bench_cifrar_expandindo(claro, len, cifrado);
+        }
+        uint64_t t_cifra_antes = time_us_64() - t0;
+
+        t0 = time_us_64();
+        for (int i = 0; i < BENCH_CRIPTOGRAFIAS; i++) {
+            security_encrypt_buffer(claro, len, cifrado, &len_cifrado);
+        }
+        uint64_t t_cifra_depois = time_us_64() - t0;
+
+        t0 = time_us_64();
+        for (int i = 0; i < BENCH_CRIPTOGRAFIAS; i++) {
+            bench_decifrar_expandindo(cifrado, len_cifrado, decifrado);
+        }
+        uint64_t t_decifra_antes = time_us_64() - t0;
+
+        t0 = time_us_64();
+        for (int i = 0; i < BENCH_CRIPTOGRAFIAS; i++) {
+            security_decrypt_message(cifrado, len_cifrado, (char *)decifrado, sizeof(decifrado));
+        }
+        uint64_t t_decifra_depois = time_us_64() - t0;
+
+        printf("[BENCH] AES-CBC %u bytes (%u cifrados): cifra %lu -> %lu ciclos, decifra %lu -> %lu ciclos (expandindo a chave -> contexto guardado)\n",
+               (unsigned)len, (unsigned)len_cifrado,
+               (unsigned long)benchmark_ciclos_por_iteracao(t_cifra_antes, BENCH_CRIPTOGRAFIAS),
+               (unsigned long)benchmark_ciclos_por_iteracao(t_cifra_depois, BENCH_CRIPTOGRAFIAS),
+               (unsigned long)benchmark_ciclos_por_iteracao(t_decifra_antes, BENCH_CRIPTOGRAFIAS),
+               (unsigned long)benchmark_ciclos_por_iteracao(t_decifra_depois, BENCH_CRIPTOGRAFIAS));
+    }
+}
+
+// ==================== AES ====================
+
+// NIST SP 800-38A, F.1.1 (ECB-AES128, os vetores do cabeçalho do aes.c) e F.2.1 (CBC-AES128)
+static const uint8_t nist_chave[16] = {
+    0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c };
+static const uint8_t nist_iv[16] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f };
+static const uint8_t nist_claro[BENCH_AES_BYTES] = {
+    0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+    0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+    0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+    0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17, 0xad, 0x2b, 0x41, 0x7b, 0xe6, 0x6c, 0x37, 0x10 };
+static const uint8_t nist_ecb[BENCH_AES_BYTES] = {
+    0x3a, 0xd7, 0x7b, 0xb4, 0x0d, 0x7a, 0x36, 0x60, 0xa8, 0x9e, 0xca, 0xf3, 0x24, 0x66, 0xef, 0x97,
+    0xf5, 0xd3, 0xd5, 0x85, 0x03, 0xb9, 0x69, 0x9d, 0xe7, 0x85, 0x89, 0x5a, 0x96, 0xfd, 0xba, 0xaf,
+    0x43, 0xb1, 0xcd, 0x7f, 0x59, 0x8e, 0xce, 0x23, 0x88, 0x1b, 0x00, 0xe3, 0xed, 0x03, 0x06, 0x88,
+    0x7b, 0x0c, 0x78, 0x5e, 0x27, 0xe8, 0xad, 0x3f, 0x82, 0x23, 0x20, 0x71, 0x04, 0x72, 0x5d, 0xd4 };
+static const uint8_t nist_cbc[BENCH_AES_BYTES] = {
+    0x76, 0x49, 0xab, 0xac, 0x81, 0x19, 0xb2, 0x46, 0xce, 0xe9, 0x8e, 0x9b, 0x12, 0xe9, 0x19, 0x7d,
+    0x50, 0x86, 0xcb, 0x9b, 0x50, 0x72, 0x19, 0xee, 0x95, 0xdb, 0x11, 0x3a, 0x91, 0x76, 0x78, 0xb2,
+    0x73, 0xbe, 0xd6, 0xb8, 0xe3, 0xc1, 0x74, 0x3b, 0x71, 0x16, 0xe6, 0x9e, 0x22, 0x22, 0x95, 0x16,
+    0x3f, 0xf1, 0xca, 0xa1, 0x68, 0x1f, 0xac, 0x09, 0x12, 0x0e, 0xca, 0x30, 0x75, 0x86, 0xe1, 0xa7 };
+
+// Confere cifra e decifra do backend compilado contra os vetores do NIST
+static bool aes_vetores_nist_ok(void) {
+    struct AES_ctx ctx;
+    uint8_t buf[BENCH_AES_BYTES];
+
+    AES_init_ctx_iv(&ctx, nist_chave, nist_iv);
+    memcpy(buf, nist_claro, sizeof(buf));
+    for (int i = 0; i < BENCH_AES_BYTES; i += AES_BLOCKLEN) {
+        AES_ECB_encrypt(&ctx, buf + i);
+    }
+    if (memcmp(buf, nist_ecb, sizeof(buf)) != 0) return false;
+    for (int i = 0; i < BENCH_AES_BYTES; i += AES_BLOCKLEN) {
+        AES_ECB_decrypt(&ctx, buf + i);
+    }
+    if (memcmp(buf, nist_claro, sizeof(buf)) != 0) return false;
+
+    memcpy(buf, nist_claro, sizeof(buf));
+    AES_CBC_encrypt_buffer(&ctx, buf, sizeof(buf));
+    if (memcmp(buf, nist_cbc, sizeof(buf)) != 0) return false;
+    AES_ctx_set_iv(&ctx, nist_iv);
+    AES_CBC_decrypt_buffer(&ctx, buf, sizeof(buf));
+    return memcmp(buf, nist_claro, sizeof(buf)) == 0;
+}
+
+bool benchmark_aes(void) {
+    struct AES_ctx ctx;
+    uint8_t buf[BENCH_AES_BYTES];
+    const char *backend = AES_TTABLES ? "T-tables" : "tiny-AES";
+
+    if (!aes_vetores_nist_ok()) {
+        printf("[BENCH] AES-128 %s: FALHOU nos vetores do NIST SP 800-38A!\n", backend);
+        return false;
+    }
+
+    AES_init_ctx_iv(&ctx, nist_chave, nist_iv);
+    memcpy(buf, nist_claro, sizeof(buf));
+
+    uint64_t t0 = time_us_64();
+    for (int i = 0; i < BENCH_CRIPTOGRAFIAS; i++) {
+        for (int b = 0; b < BENCH_AES_BYTES; b += AES_BLOCKLEN) {
+            AES_ECB_encrypt(&ctx, buf + b);
+        }
+    }
+    uint64_t t_ecb_cifra = time_us_64() - t0;
+
+    t0 = time_us_64();
+    for (int i = 0; i < BENCH_CRIPTOGRAFIAS; i++) {
+        for (int b = 0; b < BENCH_AES_BYTES; b += AES_BLOCKLEN) {
+            AES_ECB_decrypt(&ctx, buf + b);
+        }
+    }
+    uint64_t t_ecb_decifra = time_us_64() - t0;
+
+    t0 = time_us_64();
+    for (int i = 0; i < BENCH_CRIPTOGRAFIAS; i++) {
+        AES_CBC_encrypt_buffer(&ctx, buf, sizeof(buf));
+    }
+    uint64_t t_cbc_cifra = time_us_64() - t0;
+
+    t0 = time_us_64();
+    for (int i = 0; i < BENCH_CRIPTOGRAFIAS; i++) {
+        AES_CBC_decrypt_buffer(&ctx, buf, sizeof(buf));
+    }
+    uint64_t t_cbc_decifra = time_us_64() - t0;
+
+    const uint32_t bytes = BENCH_CRIPTOGRAFIAS * BENCH_AES_BYTES;
+    printf("[BENCH] AES-128 %s (vetores NIST OK): ECB cifra %lu / decifra %lu ciclos/byte, CBC cifra %lu / decifra %lu ciclos/byte\n",
+           backend,
+           (unsigned long)benchmark_ciclos_por_iteracao(t_ecb_cifra, bytes),
+           (unsigned long)benchmark_ciclos_por_iteracao(t_ecb_decifra, bytes),
+           (unsigned long)benchmark_ciclos_por_iteracao(t_cbc_cifra, bytes),
+           (unsigned long)benchmark_ciclos_por_iteracao(t_cbc_decifra, bytes));
+    return true;
+}
+
+// ==================== TODOS ====================
+
+bool benchmark_executar_todos(void) {
+    printf("\n[BENCH] ========== BENCHMARKS ==========\n");
+    benchmark_inclinacao();
+    benchmark_display_texto();
+    benchmark_display_formas();
+    bool telas_ok = benchmark_display_tela_principal();
+    benchmark_telemetria();
+    benchmark_criptografia();
+    bool aes_ok = benchmark_aes();
+    printf("[BENCH] ================================\n\n");
+    return telas_ok && aes_ok;
+}
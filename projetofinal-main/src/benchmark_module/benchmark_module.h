@@ -0,0 +1,99 @@
+/**
+ * @file benchmark_module.h
+ * @brief Micro-benchmarks dos caminhos críticos do firmware
+ *
+ * Só rodam quando o projeto é compilado com -DPROJETO_BENCHMARK=ON: o main()
+ * chama benchmark_executar_todos() antes de criar as tasks e o resultado sai
+ * no stdout. Funciona igual na placa e no build host; no host o main() sai
+ * logo depois, e o projeto_testes_host (ctest) roda os mesmos benchmarks.
+ */
+
+#ifndef BENCHMARK_MODULE_H
+#define BENCHMARK_MODULE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// ==================== FUNÇÕES PÚBLICAS ====================
+
+/**
+ * @brief Converte um tempo medido em ciclos de clk_sys por iteração
+ * @param us Tempo total medido em microssegundos
+ * @param iteracoes Quantas vezes o trecho rodou nesse tempo
+ * @return Ciclos por iteração (no host é só uma referência a 125 MHz)
+ */
+uint32_t benchmark_ciclos_por_iteracao(uint64_t us, uint32_t iteracoes);
+
+/**
+ * @brief Compara a inclinação em float com a versão CORDIC em ponto fixo
+ *
+ * Mede ciclos por chamada e o erro máximo/médio da versão inteira em
+ * relação ao float, varrendo -90° a +90° em passos de 0.1°.
+ */
+void benchmark_inclinacao(void);
+
+/**
+ * @brief Tempo pra desenhar os textos da tela da task_display no framebuffer
+ *
+ * Compara o desenho pixel a pixel (como era o ssd1306_draw_char_with_font)
+ * com o blit de colunas inteiras, em escala 1 e 2. Não usa o I2C.
+ */
+void benchmark_display_texto(void);
+
+/**
+ * @brief Tempo pra desenhar as linhas e o quadrado de alerta da task_display
+ *
+ * Compara a reta com inclinação em float e o quadrado pixel a pixel (como
+ * eram no driver) com Bresenham/spans e o preenchimento por página.
+ */
+void benchmark_display_formas(void);
+
+/**
+ * @brief Quadros por segundo da tela principal (display_module) em cada estado
+ *
+ * Mede a tela montada do zero e o quadro típico em que só o ângulo muda,
+ * nos estados normal, alerta alto/baixo, "Lendo..." e offline. No build
+ * host também manda cada tela pro OLED de captura, salva tela_<estado>.pbm
+ * no diretório do build e compara byte a byte com a referência em host/golden/.
+ * Com PROJETO_HOST_GOLDEN_ATUALIZAR=1 no ambiente regrava as referências.
+ *
+ * @return false se alguma tela saiu diferente da referência (sempre true na placa)
+ */
+bool benchmark_display_tela_principal(void);
+
+/**
+ * @brief Compara a telemetria em texto ("%.1f,...") com o registro binário
+ *
+ * Mede ciclos pra codificar (snprintf x telemetria_codificar), pra decodificar
+ * (strtof x telemetria_decodificar) e pra criptografar o payload MQTT (JSON
+ * antigo x registro de 15 bytes), além do tamanho de cada formato.
+ */
+void benchmark_telemetria(void);
+
+/**
+ * @brief Ciclos por mensagem do AES-CBC com a chave expandida a cada mensagem
+ * (como era) x o contexto guardado do security_module
+ *
+ * Mede cifrar e decifrar um registro (15 bytes) e um lote cheio (120 bytes),
+ * mais o custo da KeyExpansion sozinha.
+ */
+void benchmark_criptografia(void);
+
+/**
+ * @brief Ciclos por byte do AES-128 do backend compilado (tiny-AES ou
+ * T-tables, ver PROJETO_AES_TTABELAS)
+ *
+ * Antes de medir confere ECB e CBC contra os vetores do NIST SP 800-38A.
+ * Pra comparar os dois backends, rodar um build com a opção e outro sem.
+ *
+ * @return false se algum vetor do NIST não bateu (aí nem mede)
+ */
+bool benchmark_aes(void);
+
+/**
+ * @brief Roda todos os benchmarks em sequência
+ * @return false se alguma verificação (imagens de referência, vetores do NIST) falhou
+ */
+bool benchmark_executar_todos(void);
+
+#endif // BENCHMARK_MODULE_H
@@ -0,0 +1,375 @@
+/**
+ * @file display_module.c
+ * @brief Implementação dos widgets e da tela principal
+ */
+
+#include "display_module.h"
+#include <string.h>
+#include "atuadores_module/atuadores_module.h"
+
+// Gráfico do ângulo na tela principal: 50 colunas x 6 s = últimos 5 minutos
+#define GRAFICO_COLUNAS     50
+#define GRAFICO_PERIODO_MS  6000
+
+// Content scroll (2Ch/2Dh) do SSD1306, desligado por padrão: não é comando do
+// SSD1306 padrão, e num controlador que ignora o 2Dh os bytes de parâmetro viram
+// comandos (0x4E e 0x7F são SET_DISP_START_LINE, a tela inteira fica deslocada).
+// Sem ele o gráfico manda a área inteira a cada amostra. Ligar com
+// -DPROJETO_GRAFICO_ROLAGEM_HW=ON depois de conferir no painel
+#ifndef DISPLAY_GRAFICO_ROLAGEM_HW
+#define DISPLAY_GRAFICO_ROLAGEM_HW 0
+#endif
+
+// font_8x5: 5 colunas + 1 de espaço por caractere, 8 de altura
+#define UI_LARGURA_CHAR 6
+#define UI_ALTURA_CHAR  8
+
+// ==================== AUXILIARES ====================
+
+int ui_formatar_numero(char *dst, int32_t valor, uint8_t casas) {
+    char tmp[12];
+    int n = 0, len = 0;
+    uint32_t v = valor < 0 ? (uint32_t)(-(int64_t)valor) : (uint32_t)valor;
+
+    // Dígitos ao contrário, com o ponto depois das casas decimais
+    do {
+        if (casas && n == casas) tmp[n++] = '.';
+        tmp[n++] = (char)('0' + v % 10);
+        v /= 10;
+    } while (v || n <= casas);
+
+    if (valor < 0) dst[len++] = '-';
+    while (n) dst[len++] = tmp[--n];
+    dst[len] = '\0';
+    return len;
+}
+
+static void ui_base(ui_widget_t *w, ui_tipo_t tipo, uint8_t x, uint8_t y) {
+    memset(w, 0, sizeof(*w));
+    w->tipo = tipo;
+    w->x = x;
+    w->y = y;
+    w->escala = 1;
+    w->sujo = true;
+}
+
+// Largura do texto sem o espaço depois do último caractere
+static uint8_t ui_largura_texto(const char *s, uint8_t escala) {
+    size_t n = strlen(s);
+    return n ? (uint8_t)((n * UI_LARGURA_CHAR - 1) * escala) : 0;
+}
+
+// ==================== WIDGETS ====================
+
+void ui_rotulo(ui_widget_t *w, uint8_t x, uint8_t y, uint8_t escala, const char *texto) {
+    ui_base(w, UI_ROTULO, x, y);
+    w->escala = escala;
+    w->texto = texto;
+}
+
+void ui_numero(ui_widget_t *w, uint8_t x, uint8_t y, const char *prefixo, uint8_t casas, const char *sufixo) {
+    ui_base(w, UI_NUMERO, x, y);
+    w->texto = prefixo;
+    w->sufixo = sufixo;
+    w->casas = casas;
+    w->valor = UI_SEM_VALOR;
+}
+
+void ui_icone(ui_widget_t *w, uint8_t x, uint8_t y, const char *texto) {
+    ui_base(w, UI_ICONE, x, y);
+    w->texto = texto;
+}
+
+void ui_pisca(ui_widget_t *w, uint8_t x, uint8_t y, uint8_t largura, uint8_t altura, uint16_t periodo_ms) {
+    ui_base(w, UI_PISCA, x, y);
+    w->largura_fixa = largura;
+    w->altura_fixa = altura;
+    w->periodo_ms = periodo_ms;
+}
+
+void ui_linha(ui_widget_t *w, uint8_t x, uint8_t y, uint8_t largura) {
+    ui_base(w, UI_LINHA, x, y);
+    w->largura_fixa = largura;
+    w->altura_fixa = 1;
+}
+
+void ui_grafico(ui_widget_t *w, uint8_t x, uint8_t pagina, uint8_t largura, uint8_t paginas,
+                int16_t *amostras, int16_t minimo, int16_t maximo, bool rolagem_hw) {
+    ui_base(w, UI_GRAFICO, x, (uint8_t)(pagina * 8));
+    w->largura_fixa = largura;
+    w->altura_fixa = (uint8_t)(paginas * 8);
+    w->amostras = amostras;
+    w->minimo = minimo;
+    w->maximo = maximo;
+    w->rolagem_hw = rolagem_hw;
+}
+
+void ui_grafico_adicionar(ui_widget_t *w, int16_t valor) {
+    w->amostras[w->amostras_fim] = valor;
+    w->amostras_fim = (uint8_t)((w->amostras_fim + 1) % w->largura_fixa);
+    if (w->amostras_qtd < w->largura_fixa) w->amostras_qtd++;
+    if (w->pendentes < w->largura_fixa) w->pendentes++;
+    w->sujo = true;
+}
+
+void ui_set_texto(ui_widget_t *w, const char *texto) {
+    if (w->texto != texto) {
+        w->texto = texto;
+        w->sujo = true;
+    }
+}
+
+void ui_set_numero(ui_widget_t *w, int32_t valor) {
+    if (w->valor != valor) {
+        w->valor = valor;
+        w->sujo = true;
+    }
+}
+
+void ui_set_ativo(ui_widget_t *w, bool ativo) {
+    if (w->ativo != ativo) {
+        w->ativo = ativo;
+        w->sujo = true;
+    }
+}
+
+void ui_pisca_atualizar(ui_widget_t *w, uint32_t agora_ms) {
+    bool aceso = w->ativo && ((agora_ms / w->periodo_ms) & 1u) == 0;
+    if (w->aceso != aceso) {
+        w->aceso = aceso;
+        w->sujo = true;
+    }
+}
+
+// ==================== TELA ====================
+
+void ui_tela_init(ui_tela_t *tela, ssd1306_t *display, ui_widget_t **widgets, uint8_t quantidade) {
+    tela->display = display;
+    tela->widgets = widgets;
+    tela->quantidade = quantidade;
+    ssd1306_clear(display);
+    ui_tela_invalidar(tela);
+}
+
+void ui_tela_invalidar(ui_tela_t *tela) {
+    for (uint8_t i = 0; i < tela->quantidade; i++) {
+        tela->widgets[i]->sujo = true;
+        // O gráfico redesenha o histórico inteiro em vez de rolar
+        if (tela->widgets[i]->tipo == UI_GRAFICO) tela->widgets[i]->pendentes = tela->widgets[i]->largura_fixa;
+    }
+}
+
+// Bits das páginas cobertas pelas linhas y .. y+altura-1
+static uint8_t ui_paginas(uint8_t y, uint8_t altura) {
+    if (altura == 0) return 0;
+    uint8_t primeira = y >> 3, ultima = (uint8_t)((y + altura - 1) >> 3);
+    uint8_t mascara = 0;
+    for (uint8_t p = primeira; p <= ultima && p < 8; p++) mascara |= (uint8_t)(1u << p);
+    return mascara;
+}
+
+// Linha (y) de uma amostra dentro da caixa do gráfico
+static uint8_t ui_grafico_linha(const ui_widget_t *w, int16_t valor) {
+    int32_t v = valor < w->minimo ? w->minimo : (valor > w->maximo ? w->maximo : valor);
+    int32_t altura = w->altura_fixa - 1;
+    return (uint8_t)(w->y + altura - (v - w->minimo) * altura / (w->maximo - w->minimo));
+}
+
+// k-ésima amostra mais antiga do anel
+static int16_t ui_grafico_amostra(const ui_widget_t *w, uint8_t k) {
+    uint8_t inicio = (uint8_t)((w->amostras_fim + w->largura_fixa - w->amostras_qtd) % w->largura_fixa);
+    return w->amostras[(inicio + k) % w->largura_fixa];
+}
+
+// Coluna da amostra k, ligada na anterior com um traço vertical
+static void ui_grafico_coluna(ssd1306_t *d, const ui_widget_t *w, uint8_t k, uint8_t x) {
+    uint8_t y = ui_grafico_linha(w, ui_grafico_amostra(w, k));
+    uint8_t y_anterior = k ? ui_grafico_linha(w, ui_grafico_amostra(w, k - 1)) : y;
+    ssd1306_draw_line(d, x, y_anterior, x, y);
+}
+
+static uint8_t ui_grafico_desenhar(ssd1306_t *d, ui_widget_t *w) {
+    uint8_t direita = (uint8_t)(w->x + w->largura_fixa - 1);
+
+    if (!w->desenhado || w->pendentes >= w->amostras_qtd) {
+        // Do zero: mais recente na coluna da direita
+        ssd1306_scroll_area(d, w->x, w->largura_fixa, w->y >> 3,
+                            (uint8_t)((w->y + w->altura_fixa - 1) >> 3), w->rolagem_hw);
+        ssd1306_clear_square(d, w->x, w->y, w->largura_fixa, w->altura_fixa);
+        for (uint8_t k = 0; k < w->amostras_qtd; k++) {
+            ui_grafico_coluna(d, w, k, (uint8_t)(direita - (w->amostras_qtd - 1 - k)));
+        }
+    } else {
+        // Rola uma coluna por amostra nova; com rolagem_hw o show manda só a coluna nova
+        for (uint8_t k = (uint8_t)(w->amostras_qtd - w->pendentes); k < w->amostras_qtd; k++) {
+            ssd1306_scroll_left(d);
+            ui_grafico_coluna(d, w, k, direita);
+        }
+    }
+
+    w->pendentes = 0;
+    w->caixa_largura = w->largura_fixa;
+    w->caixa_altura = w->altura_fixa;
+    return ui_paginas(w->y, w->altura_fixa);
+}
+
+static void ui_desenhar(ssd1306_t *d, ui_widget_t *w) {
+    char buffer[32];
+    const char *texto = NULL;
+
+    switch (w->tipo) {
+        case UI_ROTULO:
+            texto = w->texto;
+            break;
+        case UI_ICONE:
+            texto = w->ativo ? w->texto : NULL;
+            break;
+        case UI_NUMERO: {
+            size_t n = strlen(w->texto);
+            memcpy(buffer, w->texto, n);
+            if (w->valor == UI_SEM_VALOR) {
+                strcpy(buffer + n, "Lendo...");
+            } else {
+                n += ui_formatar_numero(buffer + n, w->valor, w->casas);
+                strcpy(buffer + n, w->sufixo ? w->sufixo : "");
+            }
+            texto = buffer;
+            break;
+        }
+        case UI_PISCA:
+            if (w->aceso) ssd1306_draw_square(d, w->x, w->y, w->largura_fixa, w->altura_fixa);
+            w->caixa_largura = w->largura_fixa;
+            w->caixa_altura = w->altura_fixa;
+            return;
+        case UI_LINHA:
+            ssd1306_draw_line(d, w->x, w->y, w->x + w->largura_fixa - 1, w->y);
+            w->caixa_largura = w->largura_fixa;
+            w->caixa_altura = 1;
+            return;
+        case UI_GRAFICO:
+            return;     // Desenhado em ui_grafico_desenhar
+    }
+
+    if (texto) {
+        ssd1306_draw_string(d, w->x, w->y, w->escala, texto);
+        w->caixa_largura = ui_largura_texto(texto, w->escala);
+        w->caixa_altura = (uint8_t)(UI_ALTURA_CHAR * w->escala);
+    } else {
+        w->caixa_largura = 0;
+        w->caixa_altura = 0;
+    }
+}
+
+uint8_t ui_tela_renderizar(ui_tela_t *tela) {
+    uint8_t paginas = 0;
+
+    for (uint8_t i = 0; i < tela->quantidade; i++) {
+        ui_widget_t *w = tela->widgets[i];
+        if (!w->sujo) continue;
+
+        if (w->tipo == UI_GRAFICO) {
+            paginas |= ui_grafico_desenhar(tela->display, w);
+            w->desenhado = true;
+            w->sujo = false;
+            continue;
+        }
+
+        // Apaga o desenho anterior (a caixa dele pode ser maior que a nova)
+        if (w->desenhado && w->caixa_largura) {
+            ssd1306_clear_square(tela->display, w->x, w->y, w->caixa_largura, w->caixa_altura);
+            paginas |= ui_paginas(w->y, w->caixa_altura);
+        }
+
+        ui_desenhar(tela->display, w);
+        paginas |= ui_paginas(w->y, w->caixa_altura);
+        w->desenhado = true;
+        w->sujo = false;
+    }
+    return paginas;
+}
+
+// ==================== TELA PRINCIPAL ====================
+
+static ui_widget_t w_titulo, w_wifi, w_mqtt, w_freertos, w_pisca, w_linha_topo;
+static ui_widget_t w_angulo, w_status, w_grafico, w_linha_meio, w_temperatura, w_umidade, w_tarefas;
+
+static ui_widget_t *widgets_principal[] = {
+    &w_titulo, &w_wifi, &w_mqtt, &w_freertos, &w_pisca, &w_linha_topo,
+    &w_angulo, &w_status, &w_grafico, &w_linha_meio, &w_temperatura, &w_umidade, &w_tarefas,
+};
+
+static ui_tela_t tela_principal;
+
+// Histórico do ângulo: média de cada período vira uma coluna
+static int16_t grafico_amostras[GRAFICO_COLUNAS];
+static int32_t grafico_soma;
+static uint16_t grafico_n;
+static uint32_t grafico_proxima_ms;
+static bool grafico_iniciado;
+
+void display_tela_principal_init(ssd1306_t *display) {
+    ui_rotulo(&w_titulo, 0, 0, 1, "CAMA HOSPITALAR");
+    ui_icone(&w_wifi, 90, 0, "W");          // WiFi ok
+    ui_icone(&w_mqtt, 100, 0, "M");         // MQTT ok
+    ui_rotulo(&w_freertos, 115, 0, 1, "F"); // FreeRTOS rodando
+    ui_pisca(&w_pisca, 120, 0, 8, 8, 500);  // Quadradinho piscando quando tem alerta
+    ui_linha(&w_linha_topo, 0, 10, 128);
+
+    ui_numero(&w_angulo, 0, 14, "Angulo: ", 1, "");
+    ui_rotulo(&w_status, 0, 24, 1, "OK (30-45)");
+    // Páginas 2-3 à direita do ângulo/status; eixo de 15° abaixo a 15° acima da faixa segura
+    ui_grafico(&w_grafico, 128 - GRAFICO_COLUNAS, 2, GRAFICO_COLUNAS, 2, grafico_amostras,
+               (int16_t)((ANGULO_MIN - 15) * 10), (int16_t)((ANGULO_MAX + 15) * 10),
+               DISPLAY_GRAFICO_ROLAGEM_HW);
+    ui_linha(&w_linha_meio, 0, 34, 128);
+
+    ui_numero(&w_temperatura, 0, 38, "Temp: ", 1, " C");
+    ui_numero(&w_umidade, 0, 48, "Umid: ", 1, " %");
+    ui_numero(&w_tarefas, 0, 56, "Tasks: ", 0, "");
+
+    grafico_soma = 0;
+    grafico_n = 0;
+    grafico_iniciado = false;
+
+    ui_tela_init(&tela_principal, display, widgets_principal,
+                 sizeof(widgets_principal) / sizeof(widgets_principal[0]));
+}
+
+uint8_t display_tela_principal_atualizar(const display_valores_t *v, uint32_t agora_ms) {
+    ui_set_ativo(&w_wifi, v->wifi_conectado);
+    ui_set_ativo(&w_mqtt, v->mqtt_conectado);
+    ui_set_ativo(&w_pisca, v->alerta_ativo);
+    ui_pisca_atualizar(&w_pisca, agora_ms);
+
+    ui_set_numero(&w_angulo, v->angulo_decimos);
+
+    // Acumula o ângulo e fecha uma coluna do gráfico a cada período
+    if (!grafico_iniciado) {
+        grafico_proxima_ms = agora_ms + GRAFICO_PERIODO_MS;
+        grafico_iniciado = true;
+    }
+    grafico_soma += v->angulo_decimos;
+    grafico_n++;
+    if ((int32_t)(agora_ms - grafico_proxima_ms) >= 0) {
+        ui_grafico_adicionar(&w_grafico, (int16_t)(grafico_soma / grafico_n));
+        grafico_soma = 0;
+        grafico_n = 0;
+        grafico_proxima_ms += GRAFICO_PERIODO_MS;
+    }
+
+    // Avisa se o ângulo tá fora da faixa aceitável
+    if (!v->alerta_ativo) {
+        ui_set_texto(&w_status, "OK (30-45)");
+    } else if (v->angulo_decimos < (int16_t)(ANGULO_MIN * 10)) {
+        ui_set_texto(&w_status, "! BAIXO !");
+    } else {
+        ui_set_texto(&w_status, "! ALTO !");
+    }
+
+    // Temperatura e umidade (mostra "Lendo..." enquanto não tem dados)
+    ui_set_numero(&w_temperatura, v->dados_validos ? v->temperatura_decimos : UI_SEM_VALOR);
+    ui_set_numero(&w_umidade, v->dados_validos ? v->umidade_decimos : UI_SEM_VALOR);
+    ui_set_numero(&w_tarefas, v->tarefas);
+
+    return ui_tela_renderizar(&tela_principal);
+}
@@ -0,0 +1,152 @@
+/**
+ * @file display_module.h
+ * @brief Camada de widgets "retidos" sobre o ssd1306_t e a tela principal
+ *
+ * Cada widget guarda o último valor e a caixa onde foi desenhado. Só os que
+ * mudaram são apagados e redesenhados; o resto do framebuffer fica intocado,
+ * então quando nada muda não tem nem quadro pra mandar.
+ */
+
+#ifndef DISPLAY_MODULE_H
+#define DISPLAY_MODULE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ssd1306.h"
+
+// ==================== WIDGETS ====================
+
+// Número ainda sem leitura (mostra "Lendo...")
+#define UI_SEM_VALOR INT32_MIN
+
+typedef enum {
+    UI_ROTULO,      // Texto; muda só com ui_set_texto
+    UI_NUMERO,      // prefixo + valor inteiro (com casas decimais fixas) + sufixo
+    UI_ICONE,       // Texto que aparece/some
+    UI_PISCA,       // Quadrado cheio que pisca enquanto ativo
+    UI_LINHA,       // Linha horizontal fixa
+    UI_GRAFICO      // Histórico rolando da direita pra esquerda, uma coluna por amostra
+} ui_tipo_t;
+
+typedef struct {
+    ui_tipo_t tipo;
+    uint8_t x, y;
+    uint8_t escala;
+    const char *texto;      // Rótulo/ícone: o texto; número: prefixo
+    const char *sufixo;     // Só número
+    uint8_t casas;          // Só número: 0 ou 1 casa decimal
+    uint16_t periodo_ms;    // Só pisca: meio período
+    uint8_t largura_fixa;   // Pisca/linha/gráfico: tamanho da caixa
+    uint8_t altura_fixa;
+
+    // Só gráfico: anel com uma amostra por coluna e a faixa do eixo vertical
+    int16_t *amostras;
+    uint8_t amostras_qtd;
+    uint8_t amostras_fim;   // Onde entra a próxima
+    uint8_t pendentes;      // Amostras ainda não desenhadas
+    int16_t minimo, maximo;
+    bool rolagem_hw;        // Usa o content scroll do SSD1306 (ver ssd1306_scroll_area)
+
+    // Estado retido
+    int32_t valor;
+    bool ativo;
+    bool aceso;             // Pisca: fase atual
+    bool sujo;
+    bool desenhado;
+    uint8_t caixa_largura;  // Caixa do último desenho (pra apagar)
+    uint8_t caixa_altura;
+} ui_widget_t;
+
+typedef struct {
+    ssd1306_t *display;
+    ui_widget_t **widgets;
+    uint8_t quantidade;
+} ui_tela_t;
+
+void ui_rotulo(ui_widget_t *w, uint8_t x, uint8_t y, uint8_t escala, const char *texto);
+void ui_numero(ui_widget_t *w, uint8_t x, uint8_t y, const char *prefixo, uint8_t casas, const char *sufixo);
+void ui_icone(ui_widget_t *w, uint8_t x, uint8_t y, const char *texto);
+void ui_pisca(ui_widget_t *w, uint8_t x, uint8_t y, uint8_t largura, uint8_t altura, uint16_t periodo_ms);
+void ui_linha(ui_widget_t *w, uint8_t x, uint8_t y, uint8_t largura);
+
+/**
+ * @brief Gráfico de linha (sparkline) alinhado em páginas, pra poder rolar por hardware
+ * @param amostras Anel com espaço pra "largura" amostras (uma por coluna)
+ * @param rolagem_hw true se o controlador tem content scroll (2Ch/2Dh)
+ */
+void ui_grafico(ui_widget_t *w, uint8_t x, uint8_t pagina, uint8_t largura, uint8_t paginas,
+                int16_t *amostras, int16_t minimo, int16_t maximo, bool rolagem_hw);
+
+/**
+ * @brief Põe uma amostra nova no gráfico (entra na coluna da direita)
+ */
+void ui_grafico_adicionar(ui_widget_t *w, int16_t valor);
+
+/**
+ * @brief Troca o texto de um rótulo (compara o ponteiro: use strings constantes)
+ */
+void ui_set_texto(ui_widget_t *w, const char *texto);
+
+/**
+ * @brief Novo valor de um número (UI_SEM_VALOR = sem leitura)
+ */
+void ui_set_numero(ui_widget_t *w, int32_t valor);
+
+/**
+ * @brief Liga/desliga um ícone ou o pisca
+ */
+void ui_set_ativo(ui_widget_t *w, bool ativo);
+
+/**
+ * @brief Avança a fase do pisca conforme o relógio (não depende da taxa de quadros)
+ */
+void ui_pisca_atualizar(ui_widget_t *w, uint32_t agora_ms);
+
+/**
+ * @brief Associa os widgets à tela e marca tudo pra desenhar (limpa o framebuffer)
+ */
+void ui_tela_init(ui_tela_t *tela, ssd1306_t *display, ui_widget_t **widgets, uint8_t quantidade);
+
+/**
+ * @brief Força redesenhar todos os widgets no próximo ui_tela_renderizar
+ */
+void ui_tela_invalidar(ui_tela_t *tela);
+
+/**
+ * @brief Redesenha só os widgets sujos
+ * @return Máscara das páginas (bit n = página n) que mudaram; 0 = nada pra mandar
+ */
+uint8_t ui_tela_renderizar(ui_tela_t *tela);
+
+/**
+ * @brief Escreve um inteiro com casas decimais fixas (sem printf de float)
+ * @return Quantidade de caracteres escritos
+ */
+int ui_formatar_numero(char *dst, int32_t valor, uint8_t casas);
+
+// ==================== TELA PRINCIPAL ====================
+
+// O que a tela principal mostra (décimos onde tem casa decimal)
+typedef struct {
+    int16_t angulo_decimos;
+    int16_t temperatura_decimos;
+    int16_t umidade_decimos;
+    bool dados_validos;
+    bool alerta_ativo;
+    bool wifi_conectado;
+    bool mqtt_conectado;
+    uint8_t tarefas;
+} display_valores_t;
+
+/**
+ * @brief Monta os widgets da tela principal no display
+ */
+void display_tela_principal_init(ssd1306_t *display);
+
+/**
+ * @brief Atualiza os widgets com os valores novos e redesenha o que mudou
+ * @return Máscara das páginas que mudaram (0 = não precisa chamar o show)
+ */
+uint8_t display_tela_principal_atualizar(const display_valores_t *valores, uint32_t agora_ms);
+
+#endif // DISPLAY_MODULE_H
@@ -0,0 +1,80 @@
+/**
+ * @file fusao_module.c
+ * @brief Implementação do filtro complementar em ponto fixo
+ */
+
+#include "fusao_module.h"
+
+// a * b >> 15 sem estourar 32 bits (b em Q15, 0..32768)
+static inline int32_t mul_q15(int32_t a, int32_t b) {
+    return (a >> 15) * b + (((a & 0x7FFF) * b) >> 15);
+}
+
+// Arredonda milionésimos de grau pra décimos
+static inline int16_t udeg_para_decimos(int32_t udeg) {
+    return (int16_t)((udeg + (udeg >= 0 ? 50000 : -50000)) / 100000);
+}
+
+// ==================== IMPLEMENTAÇÃO ====================
+
+void fusao_init(fusao_t *f) {
+    f->angulo_udeg = 0;
+    f->taxa_mdps = 0;
+    f->bias_gy = 0;
+    f->soma_bias = 0;
+    f->amostras_bias = 0;
+    f->ultimo_us = 0;
+    f->inicializado = false;
+}
+
+static void fusao_atualizar(fusao_t *f, const mpu6050_amostra_t *a) {
+    int32_t acel_udeg = (int32_t)mpu6050_get_inclination_tenths(a->ax, a->ay, a->az) * 100000;
+
+    // Primeira amostra: sem histórico, confia no acelerômetro
+    if (!f->inicializado) {
+        f->angulo_udeg = acel_udeg;
+        f->ultimo_us = a->timestamp_us;
+        f->inicializado = true;
+        return;
+    }
+
+    // Enquanto calibra, a cama está parada no boot: a média do giroscópio é o bias
+    if (f->amostras_bias < FUSAO_AMOSTRAS_CALIBRACAO) {
+        f->soma_bias += a->gy;
+        if (++f->amostras_bias == FUSAO_AMOSTRAS_CALIBRACAO) {
+            f->bias_gy = f->soma_bias / FUSAO_AMOSTRAS_CALIBRACAO;
+        }
+    }
+
+    uint32_t dt_us = a->timestamp_us - f->ultimo_us;
+    f->ultimo_us = a->timestamp_us;
+    if (dt_us == 0 || dt_us > FUSAO_TAU_US) {
+        // Buraco grande nas amostras (FIFO estourou): recomeça pelo acelerômetro
+        f->angulo_udeg = acel_udeg;
+        return;
+    }
+
+    // O ângulo é atan2(ax, ...): girar +θ em torno de Y faz ax cair, então a taxa é -gy
+    // Intermediários em 64 bits: com dt até FUSAO_TAU_US, taxa * dt passa de 2^31
+    // acima de ~4 °/s e dt << 15 passa de 2^32 acima de 131 ms
+    f->taxa_mdps = -(a->gy - f->bias_gy) * 1000 / MPU6050_GYRO_LSB_POR_DPS;
+    int32_t previsto = f->angulo_udeg + (int32_t)((int64_t)f->taxa_mdps * dt_us / 1000);
+
+    // Ganho da correção pelo acelerômetro: dt / (tau + dt), em Q15
+    int32_t ganho_q15 = (int32_t)(((uint64_t)dt_us << 15) / (FUSAO_TAU_US + dt_us));
+    f->angulo_udeg = previsto + mul_q15(acel_udeg - previsto, ganho_q15);
+}
+
+void fusao_processar_bloco(fusao_t *f, const mpu6050_amostra_t *amostras, int n) {
+    for (int i = 0; i < n; i++) {
+        fusao_atualizar(f, &amostras[i]);
+    }
+}
+
+int16_t fusao_angulo_decimos(const fusao_t *f) {
+    return udeg_para_decimos(f->angulo_udeg);
+}
+
+int16_t fusao_taxa_decimos(const fusao_t *f) {
+    return (int16_t)(f->taxa_mdps / 100);
+}
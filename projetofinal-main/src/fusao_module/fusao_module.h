@@ -0,0 +1,57 @@
+/**
+ * @file fusao_module.h
+ * @brief Fusão acelerômetro + giroscópio (filtro complementar em ponto fixo)
+ *
+ * O ângulo só do acelerômetro pula quando o servo mexe ou a cama vibra.
+ * O giroscópio não sente essas acelerações, mas deriva com o tempo; o filtro
+ * complementar integra o giroscópio e vai puxando devagar pro acelerômetro.
+ */
+
+#ifndef FUSAO_MODULE_H
+#define FUSAO_MODULE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "mpu6050.h"
+
+// ==================== PARÂMETROS DO FILTRO ====================
+#define FUSAO_TAU_US                500000  // Constante de tempo do filtro (0.5 s)
+#define FUSAO_AMOSTRAS_CALIBRACAO   512     // Amostras paradas usadas pra medir o bias do giroscópio
+
+// ==================== ESTRUTURA DE ESTADO ====================
+typedef struct {
+    int32_t angulo_udeg;        // Ângulo filtrado (milionésimos de grau)
+    int32_t taxa_mdps;          // Taxa angular em torno de Y (milésimos de grau/s)
+    int32_t bias_gy;            // Bias do giroscópio Y (LSB)
+    int32_t soma_bias;          // Acumulador da calibração
+    uint16_t amostras_bias;     // Amostras já usadas na calibração
+    uint32_t ultimo_us;         // Timestamp da última amostra processada
+    bool inicializado;          // false até a primeira amostra
+} fusao_t;
+
+// ==================== FUNÇÕES PÚBLICAS ====================
+
+/**
+ * @brief Zera o estado do filtro (a próxima amostra reinicia o ângulo pelo acelerômetro)
+ */
+void fusao_init(fusao_t *f);
+
+/**
+ * @brief Processa um bloco de amostras da FIFO em ordem cronológica
+ * @param f Estado do filtro
+ * @param amostras Amostras com timestamp (mais antiga primeiro)
+ * @param n Quantidade de amostras
+ */
+void fusao_processar_bloco(fusao_t *f, const mpu6050_amostra_t *amostras, int n);
+
+/**
+ * @brief Ângulo filtrado em décimos de grau
+ */
+int16_t fusao_angulo_decimos(const fusao_t *f);
+
+/**
+ * @brief Taxa angular em décimos de grau por segundo
+ */
+int16_t fusao_taxa_decimos(const fusao_t *f);
+
+#endif // FUSAO_MODULE_H
@@ -29,4 +29,13 @@
 #define LWIP_NETIF_HOSTNAME 1
 #define MEMP_NUM_SYS_TIMEOUT 10
 
+// Pedidos MQTT abertos: toda publicação ocupa um, a QoS 1 até o PUBACK e a QoS 0
+// até o TCP terminar de mandar. 3 lotes + 1 alerta + 1 QoS 0 ("online"); com os
+// tópicos separados são 5 QoS 0 (a divisão está no mqtt_module.h)
+#if defined(MQTT_TOPICOS_SEPARADOS) && MQTT_TOPICOS_SEPARADOS
+#define MQTT_REQ_MAX_IN_FLIGHT 9
+#else
+#define MQTT_REQ_MAX_IN_FLIGHT 5
+#endif
+
 #endif /* LWIPOPTS_H */
@@ -1,4 +1,5 @@
 #include "mpu6050.h"
+#include <stdlib.h>
 
 // Inicializa o sensor MPU6050 e o barramento I2C
 void mpu6050_init(void) {
@@ -30,6 +31,17 @@ void mpu6050_read_raw(int16_t *ax, int16_t *ay, int16_t *az) {
     *az = (buffer[4] << 8) | buffer[5];
 }
 
+// Lê os valores brutos do giroscópio (eixos X, Y, Z), a partir do GYRO_XOUT_H (0x43)
+void mpu6050_read_gyro_raw(int16_t *gx, int16_t *gy, int16_t *gz) {
+    uint8_t buffer[6];
+    i2c_write_blocking(i2c0, MPU6050_ADDR, (uint8_t[]){0x43}, 1, true); // GYRO_XOUT_H
+    i2c_read_blocking(i2c0, MPU6050_ADDR, buffer, 6, false);
+
+    *gx = (buffer[0] << 8) | buffer[1];
+    *gy = (buffer[2] << 8) | buffer[3];
+    *gz = (buffer[4] << 8) | buffer[5];
+}
+
 // Calcula a inclinação (ângulo) em relação ao eixo X usando os valores do acelerômetro
 float mpu6050_get_inclination(int16_t ax, int16_t ay, int16_t az) {
     // Converte os valores brutos para 'g' (dividindo pelo fator de escala do acelerômetro)
@@ -39,4 +51,165 @@ float mpu6050_get_inclination(int16_t ax, int16_t ay, int16_t az) {
 
     // Calcula o ângulo de inclinação em graus usando a função atan2
     return atan2(ax_g, sqrt(ay_g * ay_g + az_g * az_g)) * (180.0 / M_PI);
-}
\ No newline at end of file
+}
+
+// ==================== INCLINAÇÃO EM PONTO FIXO (CORDIC) ====================
+
+// O RP2040 (Cortex-M0+) não tem FPU, então atan2/sqrt em float custam milhares
+// de ciclos. Aqui é tudo inteiro: duas passadas de CORDIC no modo vetorização,
+// a primeira pra achar sqrt(ay² + az²) e a segunda pro atan2.
+
+#define CORDIC_ITERACOES 16
+#define CORDIC_FRACAO    12     // Bits de fração das coordenadas
+#define CORDIC_INV_GANHO 19898  // 1/K em Q15 (K = 1.64676 depois de 16 iterações)
+
+// atan(2^-i) em graus, formato Q16
+static const int32_t cordic_atan_q16[CORDIC_ITERACOES] = {
+    2949120, 1740967, 919879, 466945, 234379, 117304, 58666, 29335,
+    14668, 7334, 3667, 1833, 917, 458, 229, 115
+};
+
+// Gira (x, y) até zerar y; devolve o ângulo percorrido (graus Q16) e deixa K*módulo em *x
+static int32_t cordic_vetorizar(int32_t *x, int32_t y) {
+    int32_t xi = *x;
+    int32_t angulo = 0;
+
+    for (int i = 0; i < CORDIC_ITERACOES; i++) {
+        int32_t dx = xi >> i;
+        int32_t dy = y >> i;
+        if (y > 0) {
+            xi += dy;
+            y -= dx;
+            angulo += cordic_atan_q16[i];
+        } else {
+            xi -= dy;
+            y += dx;
+            angulo -= cordic_atan_q16[i];
+        }
+    }
+
+    *x = xi;
+    return angulo;
+}
+
+// a * b >> 15 sem estourar 32 bits (evita a multiplicação de 64 bits da libgcc)
+static inline int32_t mul_q15(int32_t a, int32_t b) {
+    return (a >> 15) * b + (((a & 0x7FFF) * b) >> 15);
+}
+
+// Mesma conta do mpu6050_get_inclination, mas só com inteiros; retorna décimos de grau
+int16_t mpu6050_get_inclination_tenths(int16_t ax, int16_t ay, int16_t az) {
+    // 1ª passada: módulo de (az, ay), o ângulo não interessa
+    int32_t r = abs(az) << CORDIC_FRACAO;
+    cordic_vetorizar(&r, abs(ay) << CORDIC_FRACAO);
+    r = mul_q15(r, CORDIC_INV_GANHO);   // Tira o ganho K do CORDIC
+
+    // Eixo X na vertical: atan2 degenerado, responde direto
+    if (r == 0) {
+        return ax > 0 ? 900 : (ax < 0 ? -900 : 0);
+    }
+
+    // 2ª passada: atan2(ax, r); como r >= 0 o vetor fica sempre no semiplano direito
+    int32_t angulo_q16 = cordic_vetorizar(&r, (int32_t)ax * (1 << CORDIC_FRACAO));
+
+    // Graus Q16 -> décimos de grau, arredondando pro mais próximo
+    int32_t decimos = angulo_q16 * 10;
+    decimos += decimos >= 0 ? 32768 : -32768;
+    return (int16_t)(decimos / 65536);
+}
+
+// ==================== AQUISIÇÃO VIA FIFO ====================
+
+// Registradores usados pela FIFO
+#define REG_SMPLRT_DIV   0x19
+#define REG_CONFIG       0x1A
+#define REG_GYRO_CONFIG  0x1B
+#define REG_FIFO_EN      0x23
+#define REG_INT_STATUS   0x3A
+#define REG_USER_CTRL    0x6A
+#define REG_PWR_MGMT_1   0x6B
+#define REG_FIFO_COUNTH  0x72
+#define REG_FIFO_R_W     0x74
+
+#define FIFO_EN_ACCEL    0x08 // Bit ACCEL_FIFO_EN do FIFO_EN
+#define FIFO_EN_GYRO     0x70 // Bits XG/YG/ZG_FIFO_EN do FIFO_EN
+#define USER_CTRL_FIFO   0x40 // Liga a FIFO
+#define USER_CTRL_RESET  0x04 // Esvazia a FIFO
+#define INT_FIFO_OFLOW   0x10 // FIFO estourou (perdemos amostras)
+
+#define BYTES_POR_AMOSTRA 12  // Acelerômetro XYZ e giroscópio XYZ, 16 bits big-endian cada
+
+static uint32_t periodo_amostra_us = 1000000 / MPU6050_FIFO_TAXA_HZ;
+static uint8_t buffer_rajada[MPU6050_FIFO_MAX_AMOSTRAS * BYTES_POR_AMOSTRA];
+
+static bool mpu6050_write_reg(uint8_t reg, uint8_t valor) {
+    uint8_t cmd[2] = {reg, valor};
+    return i2c_write_blocking(i2c0, MPU6050_ADDR, cmd, 2, false) == 2;
+}
+
+static bool mpu6050_read_regs(uint8_t reg, uint8_t *dest, size_t len) {
+    // Escreve o registrador inicial e lê em sequência (repeated start, uma transação)
+    if (i2c_write_blocking(i2c0, MPU6050_ADDR, &reg, 1, true) != 1) return false;
+    return i2c_read_blocking(i2c0, MPU6050_ADDR, dest, len, false) == (int)len;
+}
+
+static void mpu6050_fifo_reset(void) {
+    mpu6050_write_reg(REG_USER_CTRL, USER_CTRL_RESET);
+    mpu6050_write_reg(REG_USER_CTRL, USER_CTRL_FIFO);
+}
+
+// Configura o sensor pra amostrar sozinho em 'taxa_hz' e empilhar acelerômetro + giroscópio na FIFO
+bool mpu6050_fifo_init(uint16_t taxa_hz) {
+    if (taxa_hz < 4 || taxa_hz > 1000) taxa_hz = MPU6050_FIFO_TAXA_HZ;
+
+    // Acorda o sensor usando o PLL do giroscópio X como clock (mais estável que o interno)
+    if (!mpu6050_write_reg(REG_PWR_MGMT_1, 0x01)) return false;
+
+    // Com o DLPF ligado (44 Hz) a taxa base é 1 kHz: taxa = 1000 / (1 + SMPLRT_DIV)
+    uint8_t divisor = (uint8_t)(1000 / taxa_hz - 1);
+    mpu6050_write_reg(REG_CONFIG, 0x03);
+    mpu6050_write_reg(REG_SMPLRT_DIV, divisor);
+    mpu6050_write_reg(REG_GYRO_CONFIG, 0x00);   // ±250 °/s (131 LSB por °/s)
+    periodo_amostra_us = 1000u * (divisor + 1u);
+
+    mpu6050_write_reg(REG_FIFO_EN, FIFO_EN_ACCEL | FIFO_EN_GYRO);
+    mpu6050_fifo_reset();
+    return true;
+}
+
+// Lê o que tiver acumulado na FIFO (até max_amostras) numa única rajada I2C.
+// Os timestamps são reconstruídos pra trás a partir de agora_us, já que a
+// amostra mais nova acabou de ser medida. Se sobrou amostra na FIFO, as lidas
+// são as mais antigas: a conta parte do total disponível, não só das lidas.
+int mpu6050_fifo_read(mpu6050_amostra_t *amostras, size_t max_amostras, uint32_t agora_us) {
+    uint8_t status, contagem[2];
+
+    if (!mpu6050_read_regs(REG_INT_STATUS, &status, 1)) return -1;
+    if (status & INT_FIFO_OFLOW) {
+        // Estourou: os dados estão desalinhados, então descarta tudo e recomeça
+        mpu6050_fifo_reset();
+        return -1;
+    }
+
+    if (!mpu6050_read_regs(REG_FIFO_COUNTH, contagem, 2)) return -1;
+    size_t disponiveis = (((size_t)contagem[0] << 8) | contagem[1]) / BYTES_POR_AMOSTRA;
+
+    if (max_amostras > MPU6050_FIFO_MAX_AMOSTRAS) max_amostras = MPU6050_FIFO_MAX_AMOSTRAS;
+    size_t n = disponiveis < max_amostras ? disponiveis : max_amostras;
+    if (n == 0) return 0;
+
+    if (!mpu6050_read_regs(REG_FIFO_R_W, buffer_rajada, n * BYTES_POR_AMOSTRA)) return -1;
+
+    for (size_t i = 0; i < n; i++) {
+        const uint8_t *b = &buffer_rajada[i * BYTES_POR_AMOSTRA];
+        amostras[i].ax = (int16_t)((b[0] << 8) | b[1]);
+        amostras[i].ay = (int16_t)((b[2] << 8) | b[3]);
+        amostras[i].az = (int16_t)((b[4] << 8) | b[5]);
+        amostras[i].gx = (int16_t)((b[6] << 8) | b[7]);
+        amostras[i].gy = (int16_t)((b[8] << 8) | b[9]);
+        amostras[i].gz = (int16_t)((b[10] << 8) | b[11]);
+        amostras[i].timestamp_us = agora_us - (uint32_t)(disponiveis - 1 - i) * periodo_amostra_us;
+    }
+
+    return (int)n;
+}
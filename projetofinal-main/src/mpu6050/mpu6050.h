@@ -12,9 +12,31 @@
 #define I2C_SDA_PIN 0    // GPIO0 para SDA do I2C0
 #define I2C_SCL_PIN 1    // GPIO1 para SCL do I2C0
 
+// Aquisição via FIFO: o sensor amostra sozinho e a gente drena em rajada
+#define MPU6050_FIFO_TAXA_HZ       1000 // Taxa de amostragem padrão da FIFO
+#define MPU6050_FIFO_TAMANHO       1024 // Tamanho da FIFO interna (bytes)
+#define MPU6050_FIFO_MAX_AMOSTRAS  64   // Máximo de amostras lidas por rajada
+
+#define MPU6050_GYRO_LSB_POR_DPS  131  // Escala do giroscópio em ±250 °/s
+
+// Uma amostra da FIFO (acelerômetro + giroscópio), com o instante (estimado) em que foi medida
+typedef struct {
+    int16_t ax, ay, az;
+    int16_t gx, gy, gz;
+    uint32_t timestamp_us;
+} mpu6050_amostra_t;
+
 
 void mpu6050_init(void);
 void mpu6050_read_raw(int16_t *ax, int16_t *ay, int16_t *az);
+void mpu6050_read_gyro_raw(int16_t *gx, int16_t *gy, int16_t *gz);
 float mpu6050_get_inclination(int16_t ax, int16_t ay, int16_t az);
+// Versão em ponto fixo (CORDIC, sem float): inclinação em décimos de grau
+int16_t mpu6050_get_inclination_tenths(int16_t ax, int16_t ay, int16_t az);
+
+// Configura divisor de taxa, filtro passa-baixa, escala do giroscópio e FIFO (não mexe no i2c_init)
+bool mpu6050_fifo_init(uint16_t taxa_hz);
+// Drena a FIFO numa rajada; retorna quantas amostras leu ou -1 se estourou/falhou
+int mpu6050_fifo_read(mpu6050_amostra_t *amostras, size_t max_amostras, uint32_t agora_us);
 
-#endif // MPU6050_I2C_H
\ No newline at end of file
+#endif // MPU6050_I2C_H
@@ -5,6 +5,7 @@
 
 #include "mqtt_module.h"
 #include "security_module/security_module.h"
+#include "telemetria_module/telemetria_module.h"
 #include <stdio.h>
 #include <string.h>
 #include "pico/stdlib.h"
@@ -16,84 +17,280 @@
 // ==================== VARIÁVEIS GLOBAIS ====================
 static MQTT_STATE_T mqtt_state = {0};
 
+// Janela de lotes QoS 1: FIFO de até MQTT_JANELA_EM_VOO lotes esperando PUBACK.
+// O callback do lwIP só marca o estado do lote; quem mexe na fila é a task
+typedef enum {
+    LOTE_LIVRE,
+    LOTE_EM_VOO,
+    LOTE_CONFIRMADO,
+    LOTE_FALHOU
+} lote_estado_t;
+
+typedef struct {
+    volatile uint8_t estado;    // lote_estado_t
+    uint8_t registros;          // Registros da fila neste lote
+    uint16_t geracao;           // Descarta callback atrasado de um uso anterior do slot
+    uint32_t fim;               // Contador livre da fila logo depois do último registro do lote
+} lote_em_voo_t;
+
+static lote_em_voo_t janela[MQTT_JANELA_EM_VOO];
+static uint32_t janela_inicio = 0;      // Lote mais antigo (contador livre)
+static uint32_t janela_fim = 0;         // Próximo slot livre (contador livre)
+static uint32_t janela_proximo = 0;     // Contador livre da fila do próximo registro a publicar
+static uint32_t janela_conexao = 0;     // mqtt_state.conexoes quando os lotes em voo saíram
+static uint16_t janela_geracao = 0;
+
+// Alerta QoS 1 em voo (um por vez, no pedido do lwIP que a janela deixa livre).
+// Usa os mesmos estados dos lotes
+static volatile uint8_t alerta_estado = LOTE_LIVRE;
+static uint16_t alerta_geracao = 0;
+static uint32_t alerta_conexao = 0;     // mqtt_state.conexoes quando o alerta saiu
+
+// Publicações QoS 0 com pedido do lwIP ocupado: a task só escreve nos enviadas/
+// esquecidas e o callback só nas terminadas (o M0+ não tem incremento atômico)
+static uint32_t qos0_enviadas = 0;
+static volatile uint32_t qos0_terminadas = 0;
+static uint32_t qos0_esquecidas = 0;    // Caíram com a conexão (o lwIP não chama o callback)
+
+// Máquina de conexão: os callbacks do lwIP só anotam eventos, o mqtt_executar() trata
+enum {
+    EVENTO_NENHUM,
+    EVENTO_CONEXAO_ACEITA,
+    EVENTO_CONEXAO_CAIU,
+    EVENTO_DNS_OK,
+    EVENTO_DNS_FALHOU
+};
+
+static volatile uint8_t evento_conexao = EVENTO_NENHUM;
+static volatile uint8_t evento_dns = EVENTO_NENHUM;
+static volatile mqtt_connection_status_t status_conexao;    // Motivo da última queda/recusa
+static uint32_t estado_desde_ms = 0;
+static uint32_t tentativa_inicio_ms = 0;
+static uint32_t proxima_tentativa_ms = 0;
+static uint32_t falhas_seguidas = 0;
+static bool ip_em_cache = false;
+static uint32_t semente = 0;
+
+static void (*aviso_rede)(void) = NULL;
+
 // ==================== FUNÇÕES PRIVADAS ====================
 
-// Callback de conexão MQTT
-static void mqtt_connection_cb(mqtt_client_t *client, void *arg, mqtt_connection_status_t status) {
-    switch(status) {
-        case MQTT_CONNECT_ACCEPTED:
-            printf("[MQTT] ✅ CONECTADO AO BROKER: %s\n", MQTT_BROKER);
-            printf("[MQTT] ✅ PRONTO PARA PUBLICAR DADOS\n");
-            mqtt_state.connected = true;
-            
-            // Publicar mensagem de status
-            mqtt_publish_message(TOPIC_STATUS, "online");
-            break;
-            
-        case MQTT_CONNECT_DISCONNECTED:
-            printf("[MQTT] ❌ DESCONECTADO DO BROKER\n");
-            mqtt_state.connected = false;
-            break;
+static void avisar(void) {
+    if (aviso_rede) {
+        aviso_rede();
+    }
+}
 
-        case MQTT_CONNECT_TIMEOUT:
-            printf("[MQTT] ❌ TIMEOUT - Falha na conexão ao broker\n");
-            mqtt_state.connected = false;
-            break;
+// O lwIP roda na interrupção do cyw43, que pode cair em qualquer um dos núcleos:
+// tudo que a task chama nele vai entre cyw43_arch_lwip_begin/end
+static bool cliente_conectado(void) {
+    cyw43_arch_lwip_begin();
+    bool conectado = mqtt_client_is_connected(mqtt_state.mqtt_client);
+    cyw43_arch_lwip_end();
+    return conectado;
+}
 
-        default:
-            printf("[MQTT] ERRO: Status desconhecido (%d)\n", status);
-            mqtt_state.connected = false;
-            break;
+static void desconectar(void) {
+    cyw43_arch_lwip_begin();
+    mqtt_disconnect(mqtt_state.mqtt_client);
+    cyw43_arch_lwip_end();
+}
+
+// Callback de conexão MQTT. Só anota o evento: quem muda de estado é o mqtt_executar()
+static void mqtt_connection_cb(mqtt_client_t *client, void *arg, mqtt_connection_status_t status) {
+    if (status == MQTT_CONNECT_ACCEPTED) {
+        evento_conexao = EVENTO_CONEXAO_ACEITA;
+    } else {
+        // Caiu ou foi recusada: para de publicar na hora
+        mqtt_state.connected = false;
+        status_conexao = status;
+        evento_conexao = EVENTO_CONEXAO_CAIU;
     }
+    avisar();
 }
 
 // Callback DNS resolvido
 static void dns_resolved_cb(const char *name, const ip_addr_t *ipaddr, void *arg) {
-    printf("[DNS] Callback chamado para: %s\n", name ? name : "NULL");
-    
-    if(ipaddr) {
-        printf("[DNS] ✅ Resolvido: %s -> %s\n", name, ipaddr_ntoa(ipaddr));
-        
-        // Copiar endereço IP
+    if (ipaddr) {
         ip_addr_copy(mqtt_state.remote_addr, *ipaddr);
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);     // IP escrito antes do evento
+        evento_dns = EVENTO_DNS_OK;
+    } else {
+        evento_dns = EVENTO_DNS_FALHOU;
+    }
+    avisar();
+}
 
-        // Liberar cliente MQTT anterior se existir
-        if (mqtt_state.mqtt_client) {
-            printf("[MQTT] Liberando cliente anterior...\n");
-            mqtt_disconnect(mqtt_state.mqtt_client);
-            mqtt_client_free(mqtt_state.mqtt_client);
-            mqtt_state.mqtt_client = NULL;
-        }
+// Próximo número do xorshift32 (só pro jitter do backoff)
+static uint32_t aleatorio(void) {
+    if (semente == 0) {
+        semente = time_us_32() | 1u;
+    }
+    semente ^= semente << 13;
+    semente ^= semente >> 17;
+    semente ^= semente << 5;
+    return semente;
+}
 
-        // Criar cliente MQTT
-        printf("[MQTT] Criando novo cliente MQTT...\n");
+static void mudar_estado(mqtt_conexao_estado_t novo, uint32_t agora_ms) {
+    mqtt_state.estado = novo;
+    estado_desde_ms = agora_ms;
+}
+
+// Espera metade do atraso base mais um pedaço aleatório da outra metade (assim as
+// camas não reconectam todas juntas quando o broker volta) e dobra o atraso
+static void entrar_backoff(uint32_t agora_ms, const char *motivo) {
+    uint32_t base = mqtt_state.backoff_ms;
+    uint32_t espera = base / 2 + aleatorio() % (base / 2 + 1);
+
+    proxima_tentativa_ms = agora_ms + espera;
+    mqtt_state.backoff_ms = (base >= MQTT_BACKOFF_MAX_MS / 2) ? MQTT_BACKOFF_MAX_MS : base * 2;
+
+    printf("[MQTT] ❌ %s, nova tentativa em %lu ms\n", motivo, (unsigned long)espera);
+    mudar_estado(MQTT_ESTADO_BACKOFF, agora_ms);
+}
+
+// Tentativa terminou em erro/timeout
+static void tentativa_falhou(uint32_t agora_ms, const char *motivo) {
+    mqtt_state.falhas++;
+    if (++falhas_seguidas >= MQTT_FALHAS_PARA_DNS && ip_em_cache) {
+        ip_em_cache = false;    // Talvez o broker tenha mudado de IP
+        falhas_seguidas = 0;
+    }
+    entrar_backoff(agora_ms, motivo);
+}
+
+// Manda o CONNECT pro IP que já temos, reaproveitando o cliente
+static void iniciar_conexao(uint32_t agora_ms) {
+    if (!mqtt_state.mqtt_client) {
+        cyw43_arch_lwip_begin();
         mqtt_state.mqtt_client = mqtt_client_new();
+        cyw43_arch_lwip_end();
         if (!mqtt_state.mqtt_client) {
-            printf("[MQTT] ❌ Falha ao criar cliente\n");
+            tentativa_falhou(agora_ms, "Falha ao criar cliente");
             return;
         }
-        printf("[MQTT] Cliente criado com sucesso\n");
-
-        // Configurar informações do cliente
-        struct mqtt_connect_client_info_t ci;
-        memset(&ci, 0, sizeof(ci));
-        ci.client_id = MQTT_CLIENT_ID;
-        ci.keep_alive = 60;
-        
-        printf("[MQTT] Conectando ao broker %s:%d com client_id=%s...\n", 
-             ipaddr_ntoa(ipaddr), MY_MQTT_PORT, MQTT_CLIENT_ID);
-        
-        // Conectar ao broker
-        err_t err = mqtt_client_connect(mqtt_state.mqtt_client, ipaddr, MY_MQTT_PORT, mqtt_connection_cb, NULL, &ci);
-        if (err != ERR_OK) {
-            printf("[MQTT] ❌ Erro ao conectar: %d\n", err);
-        } else {
-            printf("[MQTT] Conexão iniciada, aguardando callback...\n");
-        }
+    }
+
+    struct mqtt_connect_client_info_t ci;
+    memset(&ci, 0, sizeof(ci));
+    ci.client_id = MQTT_CLIENT_ID;
+    ci.keep_alive = 60;
+
+    evento_conexao = EVENTO_NENHUM;
+    cyw43_arch_lwip_begin();
+    err_t err = mqtt_client_connect(mqtt_state.mqtt_client, &mqtt_state.remote_addr, MY_MQTT_PORT,
+                                    mqtt_connection_cb, NULL, &ci);
+    if (err == ERR_ISCONN) {
+        // Sobrou uma conexão meio aberta da tentativa anterior
+        mqtt_disconnect(mqtt_state.mqtt_client);
+        err = mqtt_client_connect(mqtt_state.mqtt_client, &mqtt_state.remote_addr, MY_MQTT_PORT,
+                                  mqtt_connection_cb, NULL, &ci);
+    }
+    cyw43_arch_lwip_end();
+    if (err != ERR_OK) {
+        tentativa_falhou(agora_ms, "Erro ao iniciar conexão");
+        return;
+    }
+
+    printf("[MQTT] Conectando ao broker %s:%d...\n", ipaddr_ntoa(&mqtt_state.remote_addr), MY_MQTT_PORT);
+    mudar_estado(MQTT_ESTADO_CONECTANDO, agora_ms);
+}
+
+// Começa uma tentativa: com o IP em cache vai direto pro CONNECT, senão pergunta pro DNS
+static void iniciar_tentativa(uint32_t agora_ms) {
+    mqtt_state.tentativas++;
+    tentativa_inicio_ms = agora_ms;
+
+    if (ip_em_cache) {
+        iniciar_conexao(agora_ms);
+        return;
+    }
+
+    mqtt_state.consultas_dns++;
+    evento_dns = EVENTO_NENHUM;
+    cyw43_arch_lwip_begin();
+    err_t err = dns_gethostbyname(MQTT_BROKER, &mqtt_state.remote_addr, dns_resolved_cb, NULL);
+    cyw43_arch_lwip_end();
+    if (err == ERR_OK) {
+        ip_em_cache = true;     // Já estava no cache do lwIP
+        iniciar_conexao(agora_ms);
+    } else if (err == ERR_INPROGRESS) {
+        printf("[MQTT] Resolvendo %s...\n", MQTT_BROKER);
+        mudar_estado(MQTT_ESTADO_RESOLVENDO, agora_ms);
     } else {
-        printf("[DNS] ❌ Falha ao resolver %s\n", name);
+        tentativa_falhou(agora_ms, "Erro ao iniciar DNS");
+    }
+}
+
+// PUBACK (ou erro/timeout) de um lote de telemetria. arg = geração << 8 | slot
+static void lote_publicado_cb(void *arg, err_t result) {
+    uintptr_t v = (uintptr_t)arg;
+    lote_em_voo_t *l = &janela[v & 0xFF];
+
+    if (l->geracao != (uint16_t)(v >> 8) || l->estado != LOTE_EM_VOO) {
+        return;
+    }
+    l->estado = (result == ERR_OK) ? LOTE_CONFIRMADO : LOTE_FALHOU;
+    avisar();
+}
+
+// PUBACK (ou erro/timeout) do alerta. arg = geração
+static void alerta_publicado_cb(void *arg, err_t result) {
+    if (alerta_geracao != (uint16_t)(uintptr_t)arg || alerta_estado != LOTE_EM_VOO) {
+        return;
+    }
+    alerta_estado = (result == ERR_OK) ? LOTE_CONFIRMADO : LOTE_FALHOU;
+    avisar();
+}
+
+// O TCP terminou de mandar uma publicação QoS 0 (o lwIP solta o pedido)
+static void qos0_terminada_cb(void *arg, err_t result) {
+    qos0_terminadas++;
+}
+
+static uint32_t qos0_em_voo(void) {
+    return qos0_enviadas - qos0_terminadas - qos0_esquecidas;
+}
+
+// Esquece os lotes em voo: o próximo lote recomeça do registro mais antigo da fila
+static void janela_reiniciar(void) {
+    for (int i = 0; i < MQTT_JANELA_EM_VOO; i++) {
+        janela[i].estado = LOTE_LIVRE;
     }
+    janela_inicio = janela_fim = 0;
+}
+
+#if MQTT_TOPICOS_SEPARADOS
+// Formato antigo, um tópico por campo (texto)
+static void mqtt_publicar_topicos_separados(const telemetria_t* t) {
+    char msg[16];
+
+    // As 5 ou nenhuma: no meio do caminho o lwIP recusaria as últimas
+    if (qos0_em_voo() + 5 > MQTT_PEDIDOS_QOS0) {
+        printf("[MQTT] Tópicos separados ficam pra próxima (%lu publicações QoS 0 em andamento)\n",
+               (unsigned long)qos0_em_voo());
+        return;
+    }
+
+    snprintf(msg, sizeof(msg), "%.1f", t->temperatura / 10.0f);
+    mqtt_publish_message(TOPIC_TEMPERATURA, msg);
+    cyw43_arch_poll();
+
+    snprintf(msg, sizeof(msg), "%.1f", t->umidade / 10.0f);
+    mqtt_publish_message(TOPIC_UMIDADE, msg);
+    cyw43_arch_poll();
+
+    snprintf(msg, sizeof(msg), "%.1f", t->angulo / 10.0f);
+    mqtt_publish_message(TOPIC_ANGULO, msg);
+    cyw43_arch_poll();
+
+    mqtt_publish_message(TOPIC_ALERTA, (t->flags & TELEMETRIA_FLAG_ALERTA) ? "ATIVO" : "OK");
+    cyw43_arch_poll();
+
+    mqtt_publish_message(TOPIC_STATUS, "online");
 }
+#endif
 
 // ==================== IMPLEMENTAÇÃO PÚBLICA ====================
 
@@ -102,18 +299,30 @@ MQTT_STATE_T* mqtt_get_state(void) {
 }
 
 void mqtt_publish_message(const char* topic, const char* message) {
-    if (!mqtt_state.mqtt_client || !mqtt_state.connected || !mqtt_client_is_connected(mqtt_state.mqtt_client)) {
-        printf("[MQTT] Cliente não conectado\n");
+    if (qos0_em_voo() >= MQTT_PEDIDOS_QOS0) {
+        printf("[MQTT] Sem pedido livre pra QoS 0, %s fica de fora\n", topic);
         return;
     }
+    if (mqtt_publicar_bytes(topic, (const uint8_t*)message, strlen(message), 0,
+                            qos0_terminada_cb, NULL) == ERR_OK) {
+        qos0_enviadas++;
+    }
+}
+
+err_t mqtt_publicar_bytes(const char* topic, const uint8_t* dados, size_t len,
+                          uint8_t qos, mqtt_request_cb_t cb, void* arg) {
+    if (!mqtt_state.mqtt_client || !mqtt_state.connected || !cliente_conectado()) {
+        printf("[MQTT] Cliente não conectado\n");
+        return ERR_CONN;
+    }
 
     // Criptografar mensagem usando módulo de segurança
     uint8_t encrypted_buffer[128] = {0};
     size_t encrypted_len = 0;
     
-    if (!security_encrypt_message(message, encrypted_buffer, &encrypted_len)) {
+    if (!security_encrypt_buffer(dados, len, encrypted_buffer, &encrypted_len)) {
         printf("[MQTT] Erro ao criptografar mensagem\n");
-        return;
+        return ERR_ARG;
     }
 
     // Log detalhado antes da publicação
@@ -122,38 +331,268 @@ void mqtt_publish_message(const char* topic, const char* message) {
     printf(" | Tamanho: %u\n", (unsigned int)encrypted_len);
 
     // Publicar dados criptografados
-    err_t err = mqtt_publish(mqtt_state.mqtt_client, topic, (const char*)encrypted_buffer, encrypted_len, 0, 0, NULL, NULL);
+    cyw43_arch_lwip_begin();
+    err_t err = mqtt_publish(mqtt_state.mqtt_client, topic, (const char*)encrypted_buffer, encrypted_len, qos, 0, cb, arg);
+    cyw43_arch_lwip_end();
     if(err != ERR_OK) {
         printf("[MQTT] Erro ao publicar: %d (Tópico: %s)\n", err, topic);
     } else {
         printf("[MQTT] Publicado em %s (dados criptografados)\n", topic);
     }
+    return err;
+}
+
+err_t mqtt_publicar_alerta(bool ativo) {
+    if (alerta_estado != LOTE_LIVRE) {
+        return ERR_INPROGRESS;
+    }
+
+    // Pronto antes do publish, igual aos lotes: o PUBACK pode chegar antes de ele voltar
+    alerta_geracao++;
+    alerta_conexao = mqtt_state.conexoes;
+    alerta_estado = LOTE_EM_VOO;
+
+    const char* msg = ativo ? "ATIVO" : "OK";
+    err_t err = mqtt_publicar_bytes(TOPIC_ALERTA, (const uint8_t*)msg, strlen(msg), 1,
+                                    alerta_publicado_cb, (void*)(uintptr_t)alerta_geracao);
+    if (err != ERR_OK) {
+        alerta_estado = LOTE_LIVRE;
+        return err;
+    }
+    mqtt_state.alertas_publicados++;
+    return ERR_OK;
+}
+
+mqtt_alerta_resultado_t mqtt_verificar_alerta(void) {
+    switch (alerta_estado) {
+        case LOTE_EM_VOO:
+            // Caiu (ou caiu e voltou) antes do PUBACK: o lwIP largou o pedido sem avisar
+            if (!mqtt_state.connected || alerta_conexao != mqtt_state.conexoes) {
+                alerta_estado = LOTE_LIVRE;
+                mqtt_state.alertas_falhos++;
+                return MQTT_ALERTA_FALHOU;
+            }
+            return MQTT_ALERTA_EM_VOO;
+        case LOTE_CONFIRMADO:
+            alerta_estado = LOTE_LIVRE;
+            mqtt_state.alertas_confirmados++;
+            return MQTT_ALERTA_CONFIRMADO;
+        case LOTE_FALHOU:
+            alerta_estado = LOTE_LIVRE;
+            mqtt_state.alertas_falhos++;
+            return MQTT_ALERTA_FALHOU;
+        default:
+            return MQTT_ALERTA_NENHUM;
+    }
+}
+
+int mqtt_publicar_lote(telemetria_fila_t* fila) {
+    uint8_t lote[MQTT_REGISTROS_POR_LOTE * TELEMETRIA_TAMANHO];
+    uint32_t n = 0;
+    const telemetria_t* t;
+
+    if (janela_fim - janela_inicio >= MQTT_JANELA_EM_VOO) {
+        return 0;   // Janela cheia: espera um PUBACK
+    }
+
+    // Janela vazia: recomeça do registro mais antigo, na conexão atual
+    if (janela_inicio == janela_fim) {
+        janela_proximo = fila->inicio;
+        janela_conexao = mqtt_state.conexoes;
+    }
+    // A fila cheia pode ter descartado registros que estavam em voo
+    if ((int32_t)(janela_proximo - fila->inicio) < 0) {
+        janela_proximo = fila->inicio;
+    }
+    uint32_t offset = janela_proximo - fila->inicio;
+
+    // Registros mais antigos primeiro, concatenados num payload só
+    while (n < MQTT_REGISTROS_POR_LOTE && (t = telemetria_fila_ver(fila, offset + n)) != NULL) {
+        telemetria_codificar(t, &lote[n * TELEMETRIA_TAMANHO]);
+        n++;
+    }
+    if (n == 0) {
+        return 0;
+    }
+
+    // O slot fica pronto antes do publish: o PUBACK pode chegar antes do mqtt_publish voltar
+    uint32_t slot = janela_fim % MQTT_JANELA_EM_VOO;
+    lote_em_voo_t *l = &janela[slot];
+    l->geracao = ++janela_geracao;
+    l->registros = (uint8_t)n;
+    l->fim = janela_proximo + n;
+    l->estado = LOTE_EM_VOO;
+
+    void *arg = (void*)(uintptr_t)(((uint32_t)l->geracao << 8) | slot);
+    err_t err = mqtt_publicar_bytes(TOPIC_TELEMETRIA, lote, n * TELEMETRIA_TAMANHO, 1, lote_publicado_cb, arg);
+    if (err != ERR_OK) {
+        l->estado = LOTE_LIVRE;
+        return (err == ERR_MEM) ? 0 : -1;   // ERR_MEM: lwIP sem espaço, os registros ficam na fila
+    }
+    janela_fim++;
+    janela_proximo = l->fim;
+    mqtt_state.lotes_enviados++;
+
+#if MQTT_TOPICOS_SEPARADOS
+    // Formato antigo, um tópico por campo (texto), só com o valor mais novo
+    if (telemetria_fila_profundidade(fila) == offset + n) {
+        mqtt_publicar_topicos_separados(telemetria_fila_ver(fila, offset + n - 1));
+    }
+#endif
+
+    return (int)n;
+}
+
+uint32_t mqtt_confirmar_lotes(telemetria_fila_t* fila) {
+    uint32_t confirmados = 0;
+
+    // A conexão caiu (ou caiu e voltou) com lotes em voo: o lwIP descartou os
+    // pedidos sem chamar o callback, então manda tudo de novo
+    if (janela_inicio != janela_fim && (!mqtt_state.connected || janela_conexao != mqtt_state.conexoes)) {
+        janela_reiniciar();
+        return 0;
+    }
+
+    while (janela_inicio != janela_fim) {
+        lote_em_voo_t *l = &janela[janela_inicio % MQTT_JANELA_EM_VOO];
+
+        if (l->estado == LOTE_CONFIRMADO) {
+            // Só tira o que ainda tá na fila (a fila cheia pode ter descartado parte do lote)
+            int32_t restantes = (int32_t)(l->fim - fila->inicio);
+            if (restantes > 0) {
+                telemetria_fila_remover(fila, (uint32_t)restantes);
+            }
+            confirmados += l->registros;
+            l->estado = LOTE_LIVRE;
+            janela_inicio++;
+            mqtt_state.lotes_confirmados++;
+        } else if (l->estado == LOTE_FALHOU) {
+            // Recomeça do lote que falhou (os seguintes podem chegar em dobro)
+            mqtt_state.lotes_falhos++;
+            janela_reiniciar();
+            break;
+        } else {
+            break;
+        }
+    }
+
+    return confirmados;
+}
+
+uint32_t mqtt_registros_em_voo(const telemetria_fila_t* fila) {
+    int32_t em_voo = (int32_t)(janela_proximo - fila->inicio);
+    return (janela_inicio != janela_fim && em_voo > 0) ? (uint32_t)em_voo : 0;
+}
+
+uint32_t mqtt_lotes_em_voo(void) {
+    return janela_fim - janela_inicio;
+}
+
+void mqtt_set_aviso(void (*aviso)(void)) {
+    aviso_rede = aviso;
 }
 
 void conectar_mqtt(void) {
-    printf("[MQTT] Funcao conectar_mqtt() chamada\n");
-    fflush(stdout);
-    
+    // Fora do backoff a máquina já tenta sozinha
+    if (mqtt_state.estado == MQTT_ESTADO_BACKOFF) {
+        proxima_tentativa_ms = (uint32_t)(time_us_64() / 1000);
+    }
+    mqtt_state.backoff_ms = MQTT_BACKOFF_MIN_MS;
+}
+
+uint32_t mqtt_executar(void) {
+    uint32_t agora_ms = (uint32_t)(time_us_64() / 1000);
+
+    if (mqtt_state.backoff_ms == 0) {
+        mqtt_state.backoff_ms = MQTT_BACKOFF_MIN_MS;
+    }
+
+    // Sem WiFi não tem o que fazer: larga a conexão e espera ele voltar
     if (!mqtt_state.wifi_connected) {
-        printf("[MQTT] Não conectado ao WiFi, não é possível conectar ao broker.\n");
-        return;
+        if (mqtt_state.estado == MQTT_ESTADO_CONECTANDO || mqtt_state.estado == MQTT_ESTADO_CONECTADO) {
+            desconectar();
+            mqtt_state.connected = false;
+        }
+        if (mqtt_state.estado != MQTT_ESTADO_OCIOSO) {
+            mudar_estado(MQTT_ESTADO_OCIOSO, agora_ms);
+        }
+        return 0;
     }
-    printf("[MQTT] WiFi OK, iniciando conexão MQTT...\n");
-    printf("[MQTT] Resolvendo DNS para %s...\n", MQTT_BROKER);
-    fflush(stdout);
-    
-    cyw43_arch_poll();  // Garantir que o stack está atualizado
-    
-    err_t dns_err = dns_gethostbyname(MQTT_BROKER, &mqtt_state.remote_addr, dns_resolved_cb, NULL);
-    printf("[MQTT] dns_gethostbyname retornou: %d\n", dns_err);
-    
-    if(dns_err == ERR_OK) {
-        printf("[MQTT] DNS já em cache: %s\n", ipaddr_ntoa(&mqtt_state.remote_addr));
-        dns_resolved_cb(MQTT_BROKER, &mqtt_state.remote_addr, NULL);
-    } else if(dns_err == ERR_INPROGRESS) {
-        printf("[MQTT] Resolução DNS em progresso, aguardando callback...\n");
-    } else {
-        printf("[MQTT] Erro ao iniciar resolução DNS: %d\n", dns_err);
+
+    switch (mqtt_state.estado) {
+        case MQTT_ESTADO_OCIOSO:
+            iniciar_tentativa(agora_ms);
+            break;
+
+        case MQTT_ESTADO_RESOLVENDO:
+            if (evento_dns == EVENTO_DNS_OK) {
+                __atomic_thread_fence(__ATOMIC_SEQ_CST);
+                printf("[MQTT] DNS: %s -> %s\n", MQTT_BROKER, ipaddr_ntoa(&mqtt_state.remote_addr));
+                ip_em_cache = true;
+                iniciar_conexao(agora_ms);
+            } else if (evento_dns == EVENTO_DNS_FALHOU) {
+                tentativa_falhou(agora_ms, "Falha ao resolver o broker");
+            } else if (agora_ms - estado_desde_ms >= MQTT_TIMEOUT_DNS_MS) {
+                tentativa_falhou(agora_ms, "Timeout no DNS");
+            }
+            break;
+
+        case MQTT_ESTADO_CONECTANDO:
+            if (evento_conexao == EVENTO_CONEXAO_ACEITA) {
+                evento_conexao = EVENTO_NENHUM;
+                mqtt_state.connected = true;
+                mqtt_state.conexoes++;
+                mqtt_state.tempo_conexao_ms = agora_ms - tentativa_inicio_ms;
+                if (mqtt_state.tempo_conexao_ms > mqtt_state.tempo_conexao_max_ms) {
+                    mqtt_state.tempo_conexao_max_ms = mqtt_state.tempo_conexao_ms;
+                }
+                mqtt_state.backoff_ms = MQTT_BACKOFF_MIN_MS;
+                falhas_seguidas = 0;
+                // Conexão nova começa sem pedidos: os QoS 0 da anterior sumiram sem callback
+                qos0_esquecidas = qos0_enviadas - qos0_terminadas;
+                mudar_estado(MQTT_ESTADO_CONECTADO, agora_ms);
+
+                printf("[MQTT] ✅ CONECTADO AO BROKER: %s (%lu ms, tentativa %lu)\n", MQTT_BROKER,
+                       (unsigned long)mqtt_state.tempo_conexao_ms, (unsigned long)mqtt_state.tentativas);
+                mqtt_publish_message(TOPIC_STATUS, "online");
+            } else if (evento_conexao == EVENTO_CONEXAO_CAIU) {
+                evento_conexao = EVENTO_NENHUM;
+                printf("[MQTT] Conexão recusada (status %d)\n", (int)status_conexao);
+                tentativa_falhou(agora_ms, "Broker não aceitou a conexão");
+            } else if (agora_ms - estado_desde_ms >= MQTT_TIMEOUT_CONEXAO_MS) {
+                desconectar();
+                tentativa_falhou(agora_ms, "Timeout na conexão");
+            }
+            break;
+
+        case MQTT_ESTADO_CONECTADO:
+            if (evento_conexao == EVENTO_CONEXAO_CAIU || !cliente_conectado()) {
+                evento_conexao = EVENTO_NENHUM;
+                mqtt_state.connected = false;
+                printf("[MQTT] Conexão caiu (status %d)\n", (int)status_conexao);
+                // Estava funcionando: a primeira espera é curta
+                mqtt_state.backoff_ms = MQTT_BACKOFF_MIN_MS;
+                entrar_backoff(agora_ms, "Desconectado do broker");
+            }
+            break;
+
+        case MQTT_ESTADO_BACKOFF:
+            if ((int32_t)(agora_ms - proxima_tentativa_ms) >= 0) {
+                iniciar_tentativa(agora_ms);
+            }
+            break;
+    }
+
+    switch (mqtt_state.estado) {
+        case MQTT_ESTADO_RESOLVENDO:
+        case MQTT_ESTADO_CONECTANDO:
+            return MQTT_PASSO_MS;
+        case MQTT_ESTADO_BACKOFF: {
+            int32_t falta = (int32_t)(proxima_tentativa_ms - agora_ms);
+            return falta > 0 ? (uint32_t)falta : 1;
+        }
+        default:
+            return 0;
     }
 }
 
@@ -9,12 +9,24 @@
 #include <stdbool.h>
 #include "lwip/apps/mqtt.h"
 #include "lwip/ip_addr.h"
+#include "telemetria_module/telemetria_module.h"
 
 // ==================== CONFIGURAÇÕES MQTT ====================
 #define MQTT_BROKER "test.mosquitto.org"
 #define MY_MQTT_PORT 1883
 #define MQTT_CLIENT_ID "pico_hospital_bed_12345"
 
+// ==================== RECONEXÃO ====================
+// Backoff exponencial com jitter entre tentativas (dobra a cada falha, volta ao mínimo quando conecta)
+#define MQTT_BACKOFF_MIN_MS      1000
+#define MQTT_BACKOFF_MAX_MS      60000
+#define MQTT_TIMEOUT_DNS_MS      5000
+#define MQTT_TIMEOUT_CONEXAO_MS  10000
+// Falhas seguidas de conexão com o IP guardado antes de perguntar pro DNS de novo
+#define MQTT_FALHAS_PARA_DNS     3
+// Enquanto resolve/conecta, de quanto em quanto tempo a máquina quer rodar (os callbacks também acordam)
+#define MQTT_PASSO_MS            100
+
 // ==================== TÓPICOS MQTT ====================
 #define TOPIC_TEMPERATURA "hospital/cama/temperatura"
 #define TOPIC_UMIDADE "hospital/cama/umidade"
@@ -22,12 +34,67 @@
 #define TOPIC_STATUS "hospital/cama/status"
 #define TOPIC_ALERTA "hospital/cama01/alerta"
 
+// Telemetria agregada: registros binários do telemetria_module concatenados
+#define TOPIC_TELEMETRIA "hospital/cama01/telemetria"
+
+// Registros por publicação ao drenar a fila: 8 x 15 = 120 bytes, cabe nos 128 da criptografia
+#define MQTT_REGISTROS_POR_LOTE 8
+
+// Compatibilidade: 1 = também publica cada campo no seu tópico antigo (painéis antigos)
+#ifndef MQTT_TOPICOS_SEPARADOS
+#define MQTT_TOPICOS_SEPARADOS 0
+#endif
+
+// Pedidos do lwIP (MQTT_REQ_MAX_IN_FLIGHT, no lwipopts.h): toda publicação ocupa
+// um, até a QoS 0, e o que passar disso volta ERR_MEM. Cada uso tem a sua parte,
+// senão o "online" ou os tópicos separados tomam o pedido do alerta
+#define MQTT_PEDIDOS_ALERTA     1
+#define MQTT_PEDIDOS_QOS0       (MQTT_TOPICOS_SEPARADOS ? 5 : 1)
+
+// Lotes de telemetria (QoS 1) esperando PUBACK ao mesmo tempo: o que sobra dos pedidos
+#define MQTT_JANELA_EM_VOO      (MQTT_REQ_MAX_IN_FLIGHT - MQTT_PEDIDOS_ALERTA - MQTT_PEDIDOS_QOS0)
+#if MQTT_JANELA_EM_VOO < 1
+#error "MQTT_REQ_MAX_IN_FLIGHT não cabe o alerta, as publicações QoS 0 e um lote"
+#endif
+
 // ==================== ESTRUTURA DE ESTADO ====================
+
+// Situação do último alerta entregue ao lwIP (ver mqtt_verificar_alerta)
+typedef enum {
+    MQTT_ALERTA_NENHUM,         // Nada em voo
+    MQTT_ALERTA_EM_VOO,         // Esperando o PUBACK
+    MQTT_ALERTA_CONFIRMADO,     // PUBACK com ERR_OK
+    MQTT_ALERTA_FALHOU          // Erro/timeout ou a conexão caiu antes do PUBACK
+} mqtt_alerta_resultado_t;
+
+// Estados da conexão com o broker
+typedef enum {
+    MQTT_ESTADO_OCIOSO,         // Sem WiFi ou esperando a primeira tentativa
+    MQTT_ESTADO_RESOLVENDO,     // Esperando o DNS
+    MQTT_ESTADO_CONECTANDO,     // CONNECT mandado, esperando o CONNACK
+    MQTT_ESTADO_CONECTADO,
+    MQTT_ESTADO_BACKOFF         // Falhou, esperando a próxima tentativa
+} mqtt_conexao_estado_t;
+
 typedef struct {
-    mqtt_client_t *mqtt_client;
-    ip_addr_t remote_addr;
+    mqtt_client_t *mqtt_client;     // Criado uma vez e reaproveitado nas reconexões
+    ip_addr_t remote_addr;          // IP do broker (fica em cache entre reconexões)
     bool connected;
     bool wifi_connected;
+    mqtt_conexao_estado_t estado;
+    uint32_t tentativas;            // Tentativas de conexão desde o boot
+    uint32_t falhas;                // Tentativas que terminaram em erro/timeout
+    uint32_t consultas_dns;         // Quantas vezes precisou resolver o nome
+    uint32_t tempo_conexao_ms;      // Duração da última conexão bem-sucedida (início da tentativa -> CONNACK)
+    uint32_t tempo_conexao_max_ms;
+    uint32_t backoff_ms;            // Atraso base da próxima espera (sem jitter)
+    uint32_t conexoes;              // Conexões aceitas pelo broker desde o boot
+    uint32_t lotes_enviados;        // Lotes de telemetria publicados com QoS 1
+    uint32_t lotes_confirmados;     // Lotes com PUBACK
+    uint32_t lotes_falhos;          // Lotes que voltaram com erro/timeout (reenviados)
+    uint32_t alertas_publicados;    // Mudanças de alerta publicadas pelo caminho rápido
+    uint32_t alertas_confirmados;   // Alertas com PUBACK
+    uint32_t alertas_falhos;        // Alertas que voltaram com erro/timeout ou perderam a conexão
 } MQTT_STATE_T;
 
 // ==================== FUNÇÕES PÚBLICAS ====================
@@ -39,17 +106,116 @@ typedef struct {
 MQTT_STATE_T* mqtt_get_state(void);
 
 /**
- * @brief Publica uma mensagem MQTT com criptografia AES
+ * @brief Publica uma mensagem MQTT com criptografia AES (QoS 0)
+ *
+ * Usa um dos MQTT_PEDIDOS_QOS0 pedidos do lwIP até o TCP mandar; sem pedido
+ * livre a mensagem fica de fora (e aparece no log).
+ *
  * @param topic Tópico MQTT
  * @param message Mensagem em texto plano
  */
 void mqtt_publish_message(const char* topic, const char* message);
 
 /**
- * @brief Conecta ao broker MQTT
+ * @brief Publica dados binários com criptografia AES
+ * @param topic Tópico MQTT
+ * @param dados Dados em claro
+ * @param len Tamanho dos dados
+ * @param qos 0 ou 1
+ * @param cb Chamado quando a publicação termina (com QoS 1, no PUBACK); pode ser NULL
+ * @param arg Argumento repassado pro cb
+ * @return ERR_OK, ERR_MEM se o buffer de saída ou os pedidos do lwIP estão cheios, ou outro erro
+ */
+err_t mqtt_publicar_bytes(const char* topic, const uint8_t* dados, size_t len,
+                          uint8_t qos, mqtt_request_cb_t cb, void* arg);
+
+/**
+ * @brief Publica a mudança do alerta em TOPIC_ALERTA ("ATIVO"/"OK", QoS 1)
+ *
+ * Caminho rápido, fora da fila de telemetria: não espera o ciclo nem a janela
+ * de lotes (tem um pedido do lwIP reservado pra ele). Só um alerta fica em
+ * voo por vez; o resultado sai em mqtt_verificar_alerta().
+ *
+ * @return ERR_OK se foi pro lwIP, ERR_INPROGRESS se o anterior ainda espera
+ * o PUBACK, ERR_MEM se o buffer de saída está cheio (tentar de novo depois
+ * do próximo poll), ERR_CONN sem conexão
+ */
+err_t mqtt_publicar_alerta(bool ativo);
+
+/**
+ * @brief Resultado do alerta em voo
+ *
+ * CONFIRMADO e FALHOU são entregues uma vez só e liberam o próximo alerta.
+ * Se a conexão caiu com o alerta em voo (o lwIP descarta o pedido sem chamar
+ * o callback), devolve FALHOU: quem publicou decide se reenvia.
+ */
+mqtt_alerta_resultado_t mqtt_verificar_alerta(void);
+
+/**
+ * @brief Publica o próximo lote da fila de telemetria em TOPIC_TELEMETRIA (QoS 1)
+ *
+ * Junta até MQTT_REGISTROS_POR_LOTE registros que ainda não estão em voo
+ * (os mais antigos primeiro) numa publicação. Os registros continuam na
+ * fila até o PUBACK (ver mqtt_confirmar_lotes). Com MQTT_TOPICOS_SEPARADOS,
+ * quando o lote alcança o fim da fila, também manda o registro mais novo em
+ * texto nos tópicos antigos.
+ *
+ * @param fila Fila de registros esperando envio
+ * @return Registros colocados em voo; 0 se a janela ou o buffer de saída do
+ *         lwIP estão cheios, ou se não tem nada novo pra mandar; -1 em erro
+ */
+int mqtt_publicar_lote(telemetria_fila_t* fila);
+
+/**
+ * @brief Processa os PUBACKs que chegaram e tira da fila os lotes confirmados
+ *
+ * Os lotes saem da janela em ordem. Se um lote falhou (timeout) ou a conexão
+ * caiu com lotes em voo, a janela recomeça e tudo que não foi confirmado é
+ * reenviado (entrega pelo menos uma vez; o painel pode ver duplicatas).
+ * Só a task que insere na fila deve chamar.
+ *
+ * @return Registros confirmados nesta chamada
+ */
+uint32_t mqtt_confirmar_lotes(telemetria_fila_t* fila);
+
+/**
+ * @brief Registros da fila que já foram publicados e esperam PUBACK
+ */
+uint32_t mqtt_registros_em_voo(const telemetria_fila_t* fila);
+
+/**
+ * @brief Lotes publicados que ainda esperam PUBACK
+ */
+uint32_t mqtt_lotes_em_voo(void);
+
+/**
+ * @brief Define uma função chamada a cada evento de rede (PUBACK ou falha de
+ * lote ou do alerta, DNS resolvido, conexão aceita ou caída)
+ *
+ * Serve pra acordar a task que roda mqtt_executar() e drena a fila. No
+ * firmware ela roda no contexto assíncrono do cyw43 (interrupção), no host
+ * dentro do cyw43_arch_poll.
+ */
+void mqtt_set_aviso(void (*aviso)(void));
+
+/**
+ * @brief Pede uma tentativa de conexão agora, sem esperar o backoff
+ *
+ * Não bloqueia: quem faz a conexão andar é mqtt_executar().
  */
 void conectar_mqtt(void);
 
+/**
+ * @brief Avança a máquina de estados da conexão (ocioso, resolvendo,
+ * conectando, conectado, backoff). Nunca bloqueia.
+ *
+ * Reaproveita o mesmo mqtt_client_t e o IP do broker entre reconexões; só
+ * resolve o nome de novo depois de MQTT_FALHAS_PARA_DNS falhas seguidas.
+ *
+ * @return Em quantos ms a máquina quer rodar de novo (0 = só quando houver evento)
+ */
+uint32_t mqtt_executar(void);
+
 /**
  * @brief Verifica se o cliente MQTT está conectado
  * @return true se conectado, false caso contrário
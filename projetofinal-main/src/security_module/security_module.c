@@ -13,23 +13,35 @@
 static const uint8_t AES_KEY[16] = { 'S', 'E', 'G', 'U', 'R', 'A', 'N', 'C', 'A', '1', '2', '3', '4', '5', '6', '7' };
 static const uint8_t AES_IV[16]  = { 'I', 'N', 'I', 'C', 'I', 'A', 'L', 'I', 'V', '1', '2', '3', '4', '5', '6', '7' };
 
+// ==================== CONTEXTOS ====================
+// Round keys expandidas uma vez no security_init(); o CBC vai alterando o Iv do
+// contexto, então cifrar e decifrar têm cada um o seu
+static struct AES_ctx ctx_cifrar;
+static struct AES_ctx ctx_decifrar;
+static bool contextos_prontos = false;
+
 // ==================== IMPLEMENTAÇÃO ====================
 
+void security_init(void) {
+    AES_init_ctx_iv(&ctx_cifrar, AES_KEY, AES_IV);
+    AES_init_ctx_iv(&ctx_decifrar, AES_KEY, AES_IV);
+    contextos_prontos = true;
+}
+
 bool security_encrypt_message(const char* message, uint8_t* output, size_t* output_len) {
-    if (!message || !output || !output_len) {
+    if (!message) {
         return false;
     }
+    return security_encrypt_buffer((const uint8_t*)message, strlen(message), output, output_len);
+}
 
-    // Copiar IV para uso (será modificado durante criptografia)
-    uint8_t iv[16];
-    memcpy(iv, AES_IV, 16);
-
-    // Inicializar contexto AES
-    struct AES_ctx ctx;
-    AES_init_ctx_iv(&ctx, AES_KEY, iv);
+bool security_encrypt_buffer(const uint8_t* data, size_t len, uint8_t* output, size_t* output_len) {
+    if (!data || !output || !output_len) {
+        return false;
+    }
 
     // Calcular tamanho com PKCS7 padding
-    size_t msg_len = strlen(message);
+    size_t msg_len = len;
     size_t padded_len = ((msg_len / 16) + 1) * 16;
     
     if (padded_len > 128) {
@@ -39,7 +51,7 @@ bool security_encrypt_message(const char* message, uint8_t* output, size_t* outp
 
     // Copiar mensagem para buffer de saída
     memset(output, 0, padded_len);
-    memcpy(output, message, msg_len);
+    memcpy(output, data, msg_len);
 
     // Aplicar PKCS7 padding
     uint8_t pad = padded_len - msg_len;
@@ -47,8 +59,12 @@ bool security_encrypt_message(const char* message, uint8_t* output, size_t* outp
         output[i] = pad;
     }
 
-    // Criptografar
-    AES_CBC_encrypt_buffer(&ctx, output, padded_len);
+    // Criptografar (a chave já está expandida, só volta o IV pro inicial)
+    if (!contextos_prontos) {
+        security_init();
+    }
+    AES_ctx_set_iv(&ctx_cifrar, AES_IV);
+    AES_CBC_encrypt_buffer(&ctx_cifrar, output, padded_len);
 
     *output_len = padded_len;
     return true;
@@ -63,19 +79,15 @@ bool security_decrypt_message(const uint8_t* encrypted, size_t encrypted_len, ch
         return false;
     }
 
-    // Copiar IV para uso
-    uint8_t iv[16];
-    memcpy(iv, AES_IV, 16);
-
-    // Inicializar contexto AES
-    struct AES_ctx ctx;
-    AES_init_ctx_iv(&ctx, AES_KEY, iv);
-
     // Copiar dados para buffer de saída
     memcpy(output, encrypted, encrypted_len);
 
     // Descriptografar
-    AES_CBC_decrypt_buffer(&ctx, (uint8_t*)output, encrypted_len);
+    if (!contextos_prontos) {
+        security_init();
+    }
+    AES_ctx_set_iv(&ctx_decifrar, AES_IV);
+    AES_CBC_decrypt_buffer(&ctx_decifrar, (uint8_t*)output, encrypted_len);
 
     // Remover PKCS7 padding
     uint8_t pad = output[encrypted_len - 1];
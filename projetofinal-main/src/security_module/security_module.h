@@ -12,6 +12,15 @@
 
 // ==================== FUNÇÕES PÚBLICAS ====================
 
+/**
+ * @brief Expande a chave AES uma vez só (round keys guardadas no módulo)
+ *
+ * Chamar no boot, antes de criar as tasks. Se esquecer, a primeira
+ * criptografia chama sozinha. Depois disso cada mensagem só recarrega o IV.
+ * Os contextos são do módulo: criptografar (e descriptografar) de uma task só.
+ */
+void security_init(void);
+
 /**
  * @brief Criptografa uma mensagem usando AES CBC com PKCS7 padding
  * @param message Mensagem em texto plano para criptografar
@@ -21,6 +30,16 @@
  */
 bool security_encrypt_message(const char* message, uint8_t* output, size_t* output_len);
 
+/**
+ * @brief Criptografa dados binários (ex.: registro de telemetria) com AES CBC e PKCS7
+ * @param data Dados em claro
+ * @param len Tamanho dos dados
+ * @param output Buffer de saída (deve ter pelo menos 128 bytes)
+ * @param output_len Ponteiro para armazenar o tamanho dos dados criptografados
+ * @return true se criptografou com sucesso, false caso contrário
+ */
+bool security_encrypt_buffer(const uint8_t* data, size_t len, uint8_t* output, size_t* output_len);
+
 /**
  * @brief Descriptografa uma mensagem usando AES CBC com PKCS7 padding
  * @param encrypted Dados criptografados
@@ -78,22 +78,35 @@ void uart_esp_init(void) {
            UART_ESP_TX_PIN, UART_ESP_RX_PIN, UART_ESP_BAUD_RATE);
 }
 
-void uart_esp_enviar_dados(float temperatura, float umidade, float angulo, bool alerta) {
+void uart_esp_enviar_telemetria(const telemetria_t* t) {
     // Verificar se transmissão está habilitada (controlada por interrupção)
     if (!uart_transmissao_ativa) {
         return;  // Transmissão desabilitada pelo Botão B
     }
     
+#if UART_ESP_TEXTO
     char buffer[64];
     
-    // Formato: TEMP,UMID,ANGULO,ALERTA\n
+    // Formato antigo: TEMP,UMID,ANGULO,ALERTA\n
     int len = snprintf(buffer, sizeof(buffer), "%.1f,%.1f,%.1f,%d\n", 
-                       temperatura, umidade, angulo, alerta ? 1 : 0);
+                       t->temperatura / 10.0f, t->umidade / 10.0f, t->angulo / 10.0f,
+                       (t->flags & TELEMETRIA_FLAG_ALERTA) ? 1 : 0);
     
-    // Enviar via UART
     uart_write_blocking(UART_ESP_ID, (const uint8_t*)buffer, len);
     
     printf("[UART->ESP] Enviado: %s", buffer);
+#else
+    uint8_t quadro[2 + TELEMETRIA_TAMANHO];
+    
+    // Sincronismo + registro binário (o ESP32 procura o 0xAA 0x55 e confere o CRC)
+    quadro[0] = UART_ESP_SYNC_1;
+    quadro[1] = UART_ESP_SYNC_2;
+    size_t len = 2 + telemetria_codificar(t, &quadro[2]);
+    
+    uart_write_blocking(UART_ESP_ID, quadro, len);
+    
+    printf("[UART->ESP] Enviado registro #%u (%u bytes)\n", t->sequencia, (unsigned)len);
+#endif
 }
 
 void botoes_init(void) {
@@ -9,6 +9,7 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include "hardware/i2c.h"
+#include "telemetria_module/telemetria_module.h"
 
 // ==================== DEFINIÇÕES DE PINOS I2C ====================
 #define I2C0_SDA_PIN 0
@@ -22,6 +23,15 @@
 #define UART_ESP_TX_PIN 8
 #define UART_ESP_RX_PIN 9
 
+// Quadro binário: 0xAA 0x55 + registro do telemetria_module (o CRC fica no registro)
+#define UART_ESP_SYNC_1 0xAA
+#define UART_ESP_SYNC_2 0x55
+
+// Compatibilidade: 1 = manda a linha de texto antiga "TEMP,UMID,ANGULO,ALERTA\n"
+#ifndef UART_ESP_TEXTO
+#define UART_ESP_TEXTO 0
+#endif
+
 // ==================== DEFINIÇÕES BOTÕES ====================
 #define BOTAO_A_PIN 5  // Inicia transmissão UART
 #define BOTAO_B_PIN 6  // Para transmissão UART
@@ -51,16 +61,13 @@ void i2c_scan(i2c_inst_t *i2c, const char* bus_name);
 void uart_esp_init(void);
 
 /**
- * @brief Envia dados dos sensores para ESP32 via UART
- * @param temperatura Temperatura em °C
- * @param umidade Umidade em %
- * @param angulo Ângulo de inclinação em graus
- * @param alerta true se alerta ativo, false caso contrário
+ * @brief Envia um registro de telemetria para o ESP32 via UART
+ * @param t Registro já montado (sequência, instante e leituras)
  * 
- * Formato de envio: "TEMP,UMID,ANGULO,ALERTA\n"
- * Exemplo: "25.5,60.2,35.0,0\n"
+ * Formato de envio: 0xAA 0x55 + 15 bytes do registro (17 bytes por quadro).
+ * Com UART_ESP_TEXTO manda a linha antiga "25.5,60.2,35.0,0\n".
  */
-void uart_esp_enviar_dados(float temperatura, float umidade, float angulo, bool alerta);
+void uart_esp_enviar_telemetria(const telemetria_t* t);
 
 /**
  * @brief Inicializa os botões com interrupção
@@ -26,6 +26,9 @@ SOFTWARE.
 #include <pico/stdlib.h>
 #include <hardware/i2c.h>
 #include <pico/binary_info.h>
+#include <hardware/dma.h>
+#include <hardware/irq.h>
+#include <hardware/sync.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
@@ -33,10 +36,21 @@ SOFTWARE.
 #include "ssd1306.h"
 #include "font.h"
 
+#define SSD1306_MAX_PAGES 8
+#define SSD1306_SCROLL_CMD_LEN 7
+
+typedef struct {
+    uint8_t pg, pg_end;
+    uint8_t c0, c1;
+} ssd1306_window_t;
+
+// the DMA interrupt handler has no argument, so it finds the display here
+static ssd1306_t *dma_display=NULL;
+
 inline static void swap(int32_t *a, int32_t *b) {
-    int32_t *t=a;
+    int32_t t=*a;
     *a=*b;
-    *b=*t;
+    *b=t;
 }
 
 inline static void fancy_write(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, char *name) {
@@ -53,11 +67,39 @@ inline static void fancy_write(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src
     }
 }
 
+// waits for an async transfer (and its tail still in the i2c fifo) to finish
+static void ssd1306_wait_bus(ssd1306_t *p) {
+    if(p->dma_chan<0) return;
+
+    while(p->dma_busy)
+        tight_loop_contents();
+
+    i2c_hw_t *hw=i2c_get_hw(p->i2c_i);
+    while(!(hw->status&I2C_IC_STATUS_TFE_BITS) || (hw->status&I2C_IC_STATUS_MST_ACTIVITY_BITS))
+        tight_loop_contents();
+
+    if(hw->raw_intr_stat&I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS) {
+        (void)hw->clr_tx_abrt;
+        p->shadow_valid=false; // display RAM is unknown now, resend everything
+        printf("[ssd1306_show_async] transfer aborted!\n");
+    }
+}
+
 inline static void ssd1306_write(ssd1306_t *p, uint8_t val) {
+    ssd1306_wait_bus(p);
     uint8_t d[2]= {0x00, val};
     fancy_write(p->i2c_i, p->address, d, 2, "ssd1306_write");
 }
 
+// several commands after a single control byte, one i2c transaction
+static void ssd1306_write_cmds(ssd1306_t *p, const uint8_t *cmds, size_t len) {
+    ssd1306_wait_bus(p);
+    uint8_t d[16];
+    d[0]=0x00;
+    memcpy(d+1, cmds, len);
+    fancy_write(p->i2c_i, p->address, d, len+1, "ssd1306_write_cmds");
+}
+
 bool ssd1306_init(ssd1306_t *p, uint16_t width, uint16_t height, uint8_t address, i2c_inst_t *i2c_instance) {
     p->width=width;
     p->height=height;
@@ -75,6 +117,25 @@ bool ssd1306_init(ssd1306_t *p, uint16_t width, uint16_t height, uint8_t address
 
     ++(p->buffer);
 
+    if((p->shadow=malloc(p->bufsize))==NULL) {
+        free(p->buffer-1);
+        p->bufsize=0;
+        return false;
+    }
+    p->shadow_valid=false;
+    p->front=p->buffer;
+    p->swap_lock=NULL;
+    p->front_busy=false;
+    p->scroll_width=0;
+    p->scroll_pending=0;
+    p->front_scroll=0;
+    p->dma_chan=-1;
+    p->dma_stream=NULL;
+    p->dma_busy=false;
+    p->last_show_bytes=0;
+    p->show_count=0;
+    p->show_bytes_total=0;
+
     // from https://github.com/makerportal/rpi-pico-ssd1306
     uint8_t cmds[]= {
         SET_DISP,
@@ -116,7 +177,21 @@ bool ssd1306_init(ssd1306_t *p, uint16_t width, uint16_t height, uint8_t address
 }
 
 inline void ssd1306_deinit(ssd1306_t *p) {
+    if(p->dma_chan>=0) {
+        ssd1306_wait_bus(p);
+        dma_channel_set_irq0_enabled(p->dma_chan, false);
+        dma_channel_unclaim(p->dma_chan);
+        free(p->dma_stream);
+        p->dma_chan=-1;
+        dma_display=NULL;
+    }
+    if(p->swap_lock!=NULL) {
+        spin_lock_unclaim(spin_lock_get_num(p->swap_lock));
+        free(p->front-1);
+        p->swap_lock=NULL;
+    }
     free(p->buffer-1);
+    free(p->shadow);
 }
 
 inline void ssd1306_poweroff(ssd1306_t *p) {
@@ -152,38 +227,78 @@ void ssd1306_draw_pixel(ssd1306_t *p, uint32_t x, uint32_t y) {
     p->buffer[x+p->width*(y>>3)]|=0x1<<(y&0x07); // y>>3==y/8 && y&0x7==y%8
 }
 
+// sets (or clears) a rectangle a page at a time: one masked OR/AND per column,
+// memset for pages the rectangle covers completely
+static void ssd1306_fill_rect(ssd1306_t *p, int32_t x, int32_t y, int32_t width, int32_t height, bool set) {
+    if(x<0) { width+=x; x=0; }
+    if(y<0) { height+=y; y=0; }
+    if(x+width>p->width) width=p->width-x;
+    if(y+height>p->height) height=p->height-y;
+    if(width<=0 || height<=0) return;
+
+    int32_t y_end=y+height; // exclusive
+    for(int32_t page=y>>3; page<=(y_end-1)>>3; ++page) {
+        int32_t top=page<<3;
+        uint8_t mask=0xff;
+        if(y>top) mask&=0xff<<(y-top);
+        if(y_end<top+8) mask&=0xff>>(top+8-y_end);
+
+        uint8_t *col=p->buffer+page*p->width+x;
+        if(mask==0xff) {
+            memset(col, set?0xff:0x00, width);
+        } else if(set) {
+            for(int32_t i=0; i<width; ++i) col[i]|=mask;
+        } else {
+            for(int32_t i=0; i<width; ++i) col[i]&=~mask;
+        }
+    }
+}
+
 void ssd1306_draw_line(ssd1306_t *p, int32_t x1, int32_t y1, int32_t x2, int32_t y2) {
     if(x1>x2) {
         swap(&x1, &x2);
         swap(&y1, &y2);
     }
 
+    // horizontal and vertical lines are just 1 pixel wide rectangles
+    if(y1==y2) {
+        ssd1306_fill_rect(p, x1, y1, x2-x1+1, 1, true);
+        return;
+    }
     if(x1==x2) {
         if(y1>y2)
             swap(&y1, &y2);
-        for(int32_t i=y1; i<=y2; ++i)
-            ssd1306_draw_pixel(p, x1, i);
+        ssd1306_fill_rect(p, x1, y1, 1, y2-y1+1, true);
         return;
     }
 
-    float m=(float) (y2-y1) / (float) (x2-x1);
-
-    for(int32_t i=x1; i<=x2; ++i) {
-        float y=m*(float) (i-x1)+(float) y1;
-        ssd1306_draw_pixel(p, i, (uint32_t) y);
+    // integer bresenham, works for steep lines too
+    int32_t dx=x2-x1, dy=y2>y1?y2-y1:y1-y2;
+    int32_t sy=y2>y1?1:-1;
+    int32_t err=dx-dy;
+    for(;;) {
+        ssd1306_draw_pixel(p, x1, y1);
+        if(x1==x2 && y1==y2) break;
+        int32_t e2=2*err;
+        if(e2>-dy) {
+            err-=dy;
+            x1++;
+        }
+        if(e2<dx) {
+            err+=dx;
+            y1+=sy;
+        }
     }
 }
 
 void ssd1306_clear_square(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t width, uint32_t height) {
-    for(uint32_t i=0; i<width; ++i)
-        for(uint32_t j=0; j<height; ++j)
-            ssd1306_clear_pixel(p, x+i, y+j);
+    if(x>=p->width || y>=p->height) return;
+    ssd1306_fill_rect(p, x, y, width>p->width?p->width:width, height>p->height?p->height:height, false);
 }
 
 void ssd1306_draw_square(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t width, uint32_t height) {
-    for(uint32_t i=0; i<width; ++i)
-        for(uint32_t j=0; j<height; ++j)
-            ssd1306_draw_pixel(p, x+i, y+j);
+    if(x>=p->width || y>=p->height) return;
+    ssd1306_fill_rect(p, x, y, width>p->width?p->width:width, height>p->height?p->height:height, true);
 }
 
 void ssd1306_draw_empty_square(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t width, uint32_t height) {
@@ -193,10 +308,42 @@ void ssd1306_draw_empty_square(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t wi
     ssd1306_draw_line(p, x+width, y, x+width, y+height);
 }
 
+// ORs a vertical run of pixels (bit 0 at row y) into column x, across as many pages as it spans
+inline static void ssd1306_or_column(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t bits) {
+    uint32_t page=y>>3;
+    if(x>=p->width || page>=p->pages) return;
+
+    bits<<=(y&7);
+    for(uint8_t *col=p->buffer+x+page*p->width; bits && page<p->pages; ++page, col+=p->width, bits>>=8)
+        *col|=bits&0xff;
+}
+
+// each bit of a nibble doubled, for scale 2 glyphs
+static const uint8_t nibble_x2[16]= {
+    0x00, 0x03, 0x0C, 0x0F, 0x30, 0x33, 0x3C, 0x3F,
+    0xC0, 0xC3, 0xCC, 0xCF, 0xF0, 0xF3, 0xFC, 0xFF
+};
+
 void ssd1306_draw_char_with_font(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t scale, const uint8_t *font, char c) {
     if(c<font[3]||c>font[4])
         return;
 
+    // fonts up to 8 pixels tall have one byte per column, already in page layout:
+    // OR whole columns instead of drawing pixel by pixel
+    if(font[0]<=8 && (scale==1 || scale==2)) {
+        const uint8_t *glyph=font+5+(c-font[3])*font[1];
+        for(uint8_t w=0; w<font[1]; ++w) {
+            if(scale==1) {
+                ssd1306_or_column(p, x+w, y, glyph[w]);
+            } else {
+                uint32_t col=nibble_x2[glyph[w]&0x0F]|(nibble_x2[glyph[w]>>4]<<8);
+                ssd1306_or_column(p, x+2*w, y, col);
+                ssd1306_or_column(p, x+2*w+1, y, col);
+            }
+        }
+        return;
+    }
+
     uint32_t parts_per_line=(font[0]>>3)+((font[0]&7)>0);
     for(uint8_t w=0; w<font[1]; ++w) { // width
         uint32_t pp=(c-font[3])*font[1]*parts_per_line+w*parts_per_line+5;
@@ -286,21 +433,336 @@ void ssd1306_bmp_show_image_with_offset(ssd1306_t *p, const uint8_t *data, const
     }
 }
 
+void ssd1306_blit(ssd1306_t *p, int32_t x, int32_t y, const ssd1306_image_t *img) {
+    int32_t c0=x<0?-x:0;
+    int32_t c1=img->width;
+    if(x+c1>p->width) c1=p->width-x;
+    if(c0>=c1) return;
+
+    // an image page lands on two display pages unless y is page aligned
+    int32_t pg=y>>3;
+    uint32_t shift=y&7;
+    uint32_t img_pages=(img->height+7)/8;
+
+    for(uint32_t ip=0; ip<img_pages; ++ip, ++pg) {
+        const uint8_t *src=img->data+ip*img->width;
+        uint8_t valid=(ip==img_pages-1 && (img->height&7))?(1u<<(img->height&7))-1:0xff;
+        uint8_t m_lo=valid<<shift;
+        uint8_t m_hi=shift?valid>>(8-shift):0;
+
+        if(pg>=0 && pg<p->pages) {
+            uint8_t *dst=p->buffer+pg*p->width+x;
+            if(m_lo==0xff) {
+                memcpy(dst+c0, src+c0, c1-c0);
+            } else {
+                for(int32_t c=c0; c<c1; ++c)
+                    dst[c]=(dst[c]&~m_lo)|((src[c]<<shift)&m_lo);
+            }
+        }
+        if(m_hi && pg+1>=0 && pg+1<p->pages) {
+            uint8_t *dst=p->buffer+(pg+1)*p->width+x;
+            for(int32_t c=c0; c<c1; ++c)
+                dst[c]=(dst[c]&~m_hi)|((src[c]>>(8-shift))&m_hi);
+        }
+    }
+}
+
 inline void ssd1306_bmp_show_image(ssd1306_t *p, const uint8_t *data, const long size) {
     ssd1306_bmp_show_image_with_offset(p, data, size, 0, 0);
 }
 
+bool ssd1306_double_buffer_init(ssd1306_t *p) {
+    if(p->bufsize==0 || p->front!=p->buffer) return false;
+
+    int lock=spin_lock_claim_unused(false);
+    if(lock<0) return false;
+
+    uint8_t *back=malloc(p->bufsize+1);
+    if(back==NULL) {
+        spin_lock_unclaim(lock);
+        return false;
+    }
+
+    memcpy(++back, p->buffer, p->bufsize);
+    p->swap_lock=spin_lock_instance(lock);
+    p->buffer=back;
+    return true;
+}
+
+void ssd1306_swap(ssd1306_t *p) {
+    if(p->swap_lock==NULL) return;
+
+    // the other core may be inside a show; retry until it lets go of front.
+    // the copy happens under the lock too, send_window pokes a byte of front
+    uint32_t irq;
+    for(;;) {
+        irq=spin_lock_blocking(p->swap_lock);
+        if(!p->front_busy) break;
+        spin_unlock(p->swap_lock, irq);
+        tight_loop_contents();
+    }
+
+    uint8_t *t=p->front;
+    p->front=p->buffer;
+    p->buffer=t;
+    memcpy(p->buffer, p->front, p->bufsize);
+    // a front that was never shown still owes its scrolls to the display RAM
+    uint32_t owed=p->front_scroll+p->scroll_pending;
+    p->front_scroll=owed<0xff?owed:0xff;
+    p->scroll_pending=0;
+    spin_unlock(p->swap_lock, irq);
+}
+
+// keeps swap from exchanging the buffers while show reads front
+inline static void ssd1306_front_acquire(ssd1306_t *p) {
+    if(p->swap_lock==NULL) return;
+    uint32_t irq=spin_lock_blocking(p->swap_lock);
+    p->front_busy=true;
+    spin_unlock(p->swap_lock, irq);
+}
+
+inline static void ssd1306_front_release(ssd1306_t *p) {
+    if(p->swap_lock==NULL) return;
+    uint32_t irq=spin_lock_blocking(p->swap_lock);
+    p->front_busy=false;
+    spin_unlock(p->swap_lock, irq);
+}
+
+void ssd1306_scroll_area(ssd1306_t *p, uint8_t x, uint8_t width, uint8_t page_start, uint8_t page_end, bool hw) {
+    p->scroll_x=x;
+    p->scroll_width=width;
+    p->scroll_page_start=page_start;
+    p->scroll_page_end=page_end;
+    p->scroll_hw=hw;
+    // forgetting scrolls is always safe: shadow and display RAM stay in step, the diff resends the area
+    p->scroll_pending=0;
+}
+
+inline static void ssd1306_scroll_rows(ssd1306_t *p, uint8_t *fb, bool rotate) {
+    for(uint8_t pg=p->scroll_page_start; pg<=p->scroll_page_end && pg<p->pages; ++pg) {
+        uint8_t *row=fb+pg*p->width+p->scroll_x;
+        uint8_t first=row[0];
+        memmove(row, row+1, p->scroll_width-1);
+        row[p->scroll_width-1]=rotate?first:0;
+    }
+}
+
+void ssd1306_scroll_left(ssd1306_t *p) {
+    if(p->scroll_width==0) return;
+    ssd1306_scroll_rows(p, p->buffer, false);
+    if(p->scroll_pending<0xff)
+        ++p->scroll_pending;
+}
+
+// scrolls owed by the frame about to be shown; 1 can be done by the controller
+static bool ssd1306_take_scroll(ssd1306_t *p, uint8_t *cmds) {
+    uint8_t *n=p->swap_lock?&p->front_scroll:&p->scroll_pending;
+    bool hw=*n==1 && p->scroll_hw && p->shadow_valid;
+    *n=0;
+    if(!hw) return false;
+
+    // content scroll turns the area like a drum, the column leaving on the left comes back on the right
+    uint8_t offset=p->width==64?32:0;
+    cmds[0]=SET_SCROLL_CONTENT_LEFT;
+    cmds[1]=0x00;
+    cmds[2]=p->scroll_page_start;
+    cmds[3]=0x01;
+    cmds[4]=p->scroll_page_end;
+    cmds[5]=p->scroll_x+offset;
+    cmds[6]=p->scroll_x+p->scroll_width-1+offset;
+    ssd1306_scroll_rows(p, p->shadow, true);
+    return true;
+}
+
+inline void ssd1306_invalidate(ssd1306_t *p) {
+    p->shadow_valid=false;
+}
+
+// pages (or the whole frame) that differ from the shadow, with the changed column range of each
+static size_t ssd1306_dirty_windows(ssd1306_t *p, ssd1306_window_t *w) {
+    if(!p->shadow_valid) {
+        w[0].pg=0;
+        w[0].pg_end=p->pages-1;
+        w[0].c0=0;
+        w[0].c1=p->width-1;
+        return 1;
+    }
+
+    size_t n=0;
+    for(uint8_t pg=0; pg<p->pages && pg<SSD1306_MAX_PAGES; ++pg) {
+        const uint8_t *row=p->front+pg*p->width;
+        const uint8_t *old=p->shadow+pg*p->width;
+        int32_t c0=0, c1=p->width-1;
+
+        while(c0<p->width && row[c0]==old[c0]) ++c0;
+        if(c0==p->width) continue;
+        while(row[c1]==old[c1]) --c1;
+
+        w[n].pg=pg;
+        w[n].pg_end=pg;
+        w[n].c0=c0;
+        w[n].c1=c1;
+        ++n;
+    }
+    return n;
+}
+
+inline static size_t ssd1306_window_len(ssd1306_t *p, const ssd1306_window_t *w) {
+    return (size_t)(w->pg_end-w->pg)*p->width+(w->c1-w->c0)+1;
+}
+
+inline static void ssd1306_window_cmds(ssd1306_t *p, const ssd1306_window_t *w, uint8_t *cmds) {
+    uint8_t offset=p->width==64?32:0;
+    cmds[0]=SET_COL_ADDR;
+    cmds[1]=w->c0+offset;
+    cmds[2]=w->c1+offset;
+    cmds[3]=SET_PAGE_ADDR;
+    cmds[4]=w->pg;
+    cmds[5]=w->pg_end;
+}
+
+// sends a window straight from the buffer, returns bytes written
+static uint32_t ssd1306_send_window(ssd1306_t *p, const ssd1306_window_t *w) {
+    uint8_t cmds[6];
+    ssd1306_window_cmds(p, w, cmds);
+    ssd1306_write_cmds(p, cmds, sizeof(cmds));
+
+    // the 0x40 data prefix goes in the byte right before the window
+    // (front-1 is reserved for that), saved and restored around the write
+    uint8_t *start=p->front+w->pg*p->width+w->c0;
+    size_t len=ssd1306_window_len(p, w);
+    uint8_t saved=*(start-1);
+    *(start-1)=0x40;
+    fancy_write(p->i2c_i, p->address, start-1, len+1, "ssd1306_show");
+    *(start-1)=saved;
+
+    return (sizeof(cmds)+1)+(len+1);
+}
+
+inline static void ssd1306_account(ssd1306_t *p, uint32_t bytes) {
+    memcpy(p->shadow, p->front, p->bufsize);
+    p->shadow_valid=true;
+    p->last_show_bytes=bytes;
+    p->show_count++;
+    p->show_bytes_total+=bytes;
+}
+
 void ssd1306_show(ssd1306_t *p) {
-    uint8_t payload[]= {SET_COL_ADDR, 0, p->width-1, SET_PAGE_ADDR, 0, p->pages-1};
-    if(p->width==64) {
-        payload[1]+=32;
-        payload[2]+=32;
+    ssd1306_window_t w[SSD1306_MAX_PAGES];
+    uint32_t bytes=0;
+
+    ssd1306_front_acquire(p);
+    uint8_t scroll[SSD1306_SCROLL_CMD_LEN];
+    if(ssd1306_take_scroll(p, scroll)) {
+        ssd1306_write_cmds(p, scroll, sizeof(scroll));
+        bytes+=sizeof(scroll)+1;
     }
+    size_t n=ssd1306_dirty_windows(p, w);
+    for(size_t i=0; i<n; ++i)
+        bytes+=ssd1306_send_window(p, &w[i]);
 
-    for(size_t i=0; i<sizeof(payload); ++i)
-        ssd1306_write(p, payload[i]);
+    ssd1306_account(p, bytes);
+    ssd1306_front_release(p);
+}
+
+static void ssd1306_dma_irq_handler(void) {
+    ssd1306_t *p=dma_display;
+    if(p==NULL || !dma_channel_get_irq0_status(p->dma_chan)) return;
+
+    dma_channel_acknowledge_irq0(p->dma_chan);
+    p->dma_busy=false;
+    if(p->dma_done)
+        p->dma_done(p->dma_done_ctx);
+}
+
+bool ssd1306_dma_init(ssd1306_t *p, ssd1306_done_cb_t done, void *ctx) {
+    if(dma_display!=NULL || p->bufsize==0) return false;
+
+    // worst case: one window per page, each with 8 command words
+    p->dma_stream_size=p->bufsize+p->pages*8+SSD1306_SCROLL_CMD_LEN+1;
+    if((p->dma_stream=malloc(p->dma_stream_size*sizeof(uint16_t)))==NULL)
+        return false;
+
+    int chan=dma_claim_unused_channel(false);
+    if(chan<0) {
+        free(p->dma_stream);
+        p->dma_stream=NULL;
+        return false;
+    }
+
+    p->dma_chan=chan;
+    p->dma_busy=false;
+    p->dma_done=done;
+    p->dma_done_ctx=ctx;
+    dma_display=p;
+
+    dma_channel_set_irq0_enabled(chan, true);
+    irq_add_shared_handler(DMA_IRQ_0, ssd1306_dma_irq_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_0, true);
+    return true;
+}
 
-    *(p->buffer-1)=0x40;
+bool ssd1306_show_async(ssd1306_t *p) {
+    if(p->dma_chan<0) {
+        ssd1306_show(p);
+        return false;
+    }
+
+    ssd1306_wait_bus(p);
+
+    // front is only read while building the stream, swap can go ahead once it is done
+    ssd1306_front_acquire(p);
+    ssd1306_window_t w[SSD1306_MAX_PAGES];
+    uint16_t *s=p->dma_stream;
+    size_t words=0;
+
+    uint8_t scroll[SSD1306_SCROLL_CMD_LEN];
+    if(ssd1306_take_scroll(p, scroll)) {
+        s[words++]=0x00;
+        for(size_t j=0; j<sizeof(scroll); ++j)
+            s[words++]=scroll[j];
+        s[words-1]|=I2C_IC_DATA_CMD_STOP_BITS;
+    }
+    size_t n=ssd1306_dirty_windows(p, w);
+
+    // every byte becomes a data_cmd word; STOP on the last byte of each
+    // transaction makes the controller start the next one on its own
+    for(size_t i=0; i<n; ++i) {
+        uint8_t cmds[6];
+        ssd1306_window_cmds(p, &w[i], cmds);
+        s[words++]=0x00;
+        for(size_t j=0; j<sizeof(cmds); ++j)
+            s[words++]=cmds[j];
+        s[words-1]|=I2C_IC_DATA_CMD_STOP_BITS;
+
+        const uint8_t *src=p->front+w[i].pg*p->width+w[i].c0;
+        size_t len=ssd1306_window_len(p, &w[i]);
+        s[words++]=0x40;
+        for(size_t j=0; j<len; ++j)
+            s[words++]=src[j];
+        s[words-1]|=I2C_IC_DATA_CMD_STOP_BITS;
+    }
+
+    ssd1306_account(p, words);
+    ssd1306_front_release(p);
+    if(words==0) return false;
+
+    i2c_hw_t *hw=i2c_get_hw(p->i2c_i);
+    hw->enable=0;
+    hw->tar=p->address;
+    hw->enable=1;
+
+    dma_channel_config c=dma_channel_get_default_config(p->dma_chan);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, i2c_get_dreq(p->i2c_i, true));
+
+    p->dma_busy=true;
+    dma_channel_configure(p->dma_chan, &c, &hw->data_cmd, s, words, true);
+    return true;
+}
 
-    fancy_write(p->i2c_i, p->address, p->buffer-1, p->bufsize+1, "ssd1306_show");
+inline bool ssd1306_busy(ssd1306_t *p) {
+    return p->dma_busy;
 }
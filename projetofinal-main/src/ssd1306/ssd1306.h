@@ -32,6 +32,7 @@ SOFTWARE.
 #define _inc_ssd1306
 #include <pico/stdlib.h>
 #include <hardware/i2c.h>
+#include <hardware/sync.h>
 
 /**
 *	@brief defines commands used in ssd1306
@@ -53,9 +54,25 @@ typedef enum {
     SET_DISP_CLK_DIV = 0xD5,
     SET_PRECHARGE = 0xD9,
     SET_VCOM_DESEL = 0xDB,
-    SET_CHARGE_PUMP = 0x8D
+    SET_CHARGE_PUMP = 0x8D,
+    SET_SCROLL_CONTENT_RIGHT = 0x2C,
+    SET_SCROLL_CONTENT_LEFT = 0x2D
 } ssd1306_command_t;
 
+/**
+*	@brief called from the DMA interrupt when an async show finishes
+*/
+typedef void (*ssd1306_done_cb_t)(void *ctx);
+
+/**
+*	@brief image already in display memory layout (made by tools/imagem_para_ssd1306.py)
+*/
+typedef struct {
+    uint8_t width;		/**< width in columns */
+    uint8_t height;		/**< height in rows */
+    const uint8_t *data;	/**< (height+7)/8 pages of width bytes, bit 0 is the top row of a page */
+} ssd1306_image_t;
+
 /**
 *	@brief holds the configuration
 */
@@ -66,8 +83,29 @@ typedef struct {
     uint8_t address; 	/**< i2c address of display*/
     i2c_inst_t *i2c_i; 	/**< i2c connection instance */
     bool external_vcc; 	/**< whether display uses external vcc */ 
-    uint8_t *buffer;	/**< display buffer */
+    uint8_t *buffer;	/**< display buffer (the back buffer when double buffered) */
     size_t bufsize;		/**< buffer size */
+    uint8_t *front;		/**< frame that show sends, same as buffer unless double buffered */
+    spin_lock_t *swap_lock;	/**< guards the buffer/front exchange, NULL if single buffered */
+    volatile bool front_busy;	/**< a show is reading the front buffer */
+    uint8_t scroll_x;		/**< first column of the scroll area */
+    uint8_t scroll_width;	/**< columns in the scroll area, 0 = no area */
+    uint8_t scroll_page_start;	/**< first page of the scroll area */
+    uint8_t scroll_page_end;	/**< last page of the scroll area */
+    bool scroll_hw;		/**< move the display RAM with the controller's content scroll */
+    uint8_t scroll_pending;	/**< scrolls done in buffer since the last swap (or show) */
+    uint8_t front_scroll;	/**< scrolls done in front that the display RAM has not seen */
+    uint8_t *shadow;	/**< copy of what is currently in the display RAM */
+    bool shadow_valid;	/**< false forces the next show to send the whole buffer */
+    uint32_t last_show_bytes;	/**< bytes written to i2c by the last show */
+    uint32_t show_count;		/**< number of show calls */
+    uint64_t show_bytes_total;	/**< bytes written to i2c by all show calls */
+    int dma_chan;		/**< dma channel used by show_async, -1 if not initialized */
+    uint16_t *dma_stream;	/**< i2c data_cmd words of the transfer in flight */
+    size_t dma_stream_size;	/**< capacity of dma_stream in words */
+    volatile bool dma_busy;	/**< async transfer in flight */
+    ssd1306_done_cb_t dma_done;	/**< completion callback */
+    void *dma_done_ctx;		/**< argument for dma_done */
 } ssd1306_t;
 
 /**
@@ -130,11 +168,109 @@ void ssd1306_invert(ssd1306_t *p, uint8_t inv);
 /**
 	@brief display buffer, should be called on change
 
+	only the columns that changed in each page since the last show are sent
+
 	@param[in] p : instance of display
 
 */
 void ssd1306_show(ssd1306_t *p);
 
+/**
+	@brief forget what is in the display RAM, next show sends the whole buffer
+
+	@param[in] p : instance of display
+
+*/
+void ssd1306_invalidate(ssd1306_t *p);
+
+/**
+	@brief claim a DMA channel so ssd1306_show_async can stream the buffer to i2c
+
+	only one display per program can use it, the interrupt handler is shared
+
+	@param[in] p : instance of display
+	@param[in] done : called from the DMA interrupt when a transfer ends (can be NULL)
+	@param[in] ctx : argument passed to done
+
+	@return bool.
+	@retval true for Success
+	@retval false if no channel or memory was available (show_async then falls back to show)
+*/
+bool ssd1306_dma_init(ssd1306_t *p, ssd1306_done_cb_t done, void *ctx);
+
+/**
+	@brief same as ssd1306_show, but the transfer runs on DMA paced by the i2c TX DREQ
+
+	the buffer is copied to the transfer stream, so drawing can start again right away.
+	the i2c bus belongs to the display until done is called.
+
+	@param[in] p : instance of display
+
+	@return bool.
+	@retval true if a transfer was started (done will be called)
+	@retval false if there was nothing to send or DMA is not initialized
+*/
+bool ssd1306_show_async(ssd1306_t *p);
+
+/**
+	@brief whether an async transfer is still in flight
+
+	@param[in] p : instance of display
+*/
+bool ssd1306_busy(ssd1306_t *p);
+
+/**
+	@brief give the display a second buffer, so drawing and sending can run at the same time
+
+	drawing functions keep writing to buffer, show and show_async send front.
+	call ssd1306_swap when a frame is complete. show can then run on another core
+	(or task) while the next frame is drawn.
+
+	@param[in] p : instance of display
+
+	@return bool.
+	@retval true for Success
+	@retval false if no memory or spin lock was available (display stays single buffered)
+*/
+bool ssd1306_double_buffer_init(ssd1306_t *p);
+
+/**
+	@brief hand the drawn frame over to show
+
+	exchanges buffer and front, then copies the new front back into buffer so
+	drawing continues from the same image. waits while a show is reading front.
+	does nothing on a single buffered display.
+
+	@param[in] p : instance of display
+*/
+void ssd1306_swap(ssd1306_t *p);
+
+/**
+	@brief define the area moved by ssd1306_scroll_left
+
+	the area is whole pages high. with hw, a show after a single scroll sends the
+	one-column content scroll command and only the new column, instead of the
+	whole area. without it (or after several scrolls in one frame) the area is
+	resent as usual.
+
+	@param[in] p : instance of display
+	@param[in] x : first column
+	@param[in] width : number of columns
+	@param[in] page_start : first page
+	@param[in] page_end : last page
+	@param[in] hw : whether the controller supports content scroll (2Ch/2Dh)
+*/
+void ssd1306_scroll_area(ssd1306_t *p, uint8_t x, uint8_t width, uint8_t page_start, uint8_t page_end, bool hw);
+
+/**
+	@brief move the scroll area one column to the left in the buffer
+
+	the rightmost column of the area is cleared for new data
+
+	@param[in] p : instance of display
+*/
+void ssd1306_scroll_left(ssd1306_t *p);
+
 /**
 	@brief clear display buffer
 
@@ -225,6 +361,20 @@ void ssd1306_bmp_show_image_with_offset(ssd1306_t *p, const uint8_t *data, const
 */
 void ssd1306_bmp_show_image(ssd1306_t *p, const uint8_t *data, const long size);
 
+/**
+	@brief copy a page-format image to the buffer, a row of pages at a time
+
+	pixels inside the image rectangle are replaced (not ORed). parts outside
+	the display are clipped, x and y can be negative. when y is a multiple of 8
+	each page row is a plain memcpy.
+
+	@param[in] p : instance of display
+	@param[in] x : x position of the top left corner
+	@param[in] y : y position of the top left corner
+	@param[in] img : image to copy
+*/
+void ssd1306_blit(ssd1306_t *p, int32_t x, int32_t y, const ssd1306_image_t *img);
+
 /**
 	@brief draw char with given font
 
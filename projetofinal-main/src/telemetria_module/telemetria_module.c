@@ -0,0 +1,173 @@
+/**
+ * @file telemetria_module.c
+ * @brief Codificação/decodificação do registro binário de telemetria
+ */
+
+#include "telemetria_module.h"
+
+// ==================== AUXILIARES ====================
+
+// float -> décimos, arredondando pro mais próximo e saturando no int16
+static int16_t para_decimos_sat(float v) {
+    float d = v * 10.0f;
+    if (d >= 32767.0f) return INT16_MAX;
+    if (d <= -32768.0f) return INT16_MIN;
+    return (int16_t)(d >= 0 ? d + 0.5f : d - 0.5f);
+}
+
+static void escrever_u16(uint8_t *p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void escrever_u32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static uint16_t ler_u16(const uint8_t *p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t ler_u32(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+// ==================== IMPLEMENTAÇÃO ====================
+
+uint8_t telemetria_crc8(const uint8_t *dados, size_t len) {
+    uint8_t crc = 0xFF;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= dados[i];
+        for (int b = 0; b < 8; b++) {
+            crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x31) : (uint8_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+void telemetria_montar(telemetria_t *t, uint16_t sequencia, uint32_t instante_ms,
+                       float temperatura, float umidade, float angulo,
+                       bool alerta, bool dados_validos) {
+    t->sequencia = sequencia;
+    t->instante_ms = instante_ms;
+    t->temperatura = para_decimos_sat(temperatura);
+    t->umidade = para_decimos_sat(umidade);
+    t->angulo = para_decimos_sat(angulo);
+    t->flags = (alerta ? TELEMETRIA_FLAG_ALERTA : 0) |
+               (dados_validos ? TELEMETRIA_FLAG_DADOS_VALIDOS : 0);
+}
+
+size_t telemetria_codificar(const telemetria_t *t, uint8_t *dst) {
+    dst[0] = TELEMETRIA_VERSAO;
+    dst[1] = t->flags;
+    escrever_u16(&dst[2], t->sequencia);
+    escrever_u32(&dst[4], t->instante_ms);
+    escrever_u16(&dst[8], (uint16_t)t->temperatura);
+    escrever_u16(&dst[10], (uint16_t)t->umidade);
+    escrever_u16(&dst[12], (uint16_t)t->angulo);
+    dst[14] = telemetria_crc8(dst, TELEMETRIA_TAMANHO - 1);
+    return TELEMETRIA_TAMANHO;
+}
+
+bool telemetria_decodificar(const uint8_t *src, size_t len, telemetria_t *t) {
+    if (len != TELEMETRIA_TAMANHO || src[0] != TELEMETRIA_VERSAO) {
+        return false;
+    }
+    if (telemetria_crc8(src, TELEMETRIA_TAMANHO - 1) != src[14]) {
+        return false;
+    }
+
+    t->flags = src[1];
+    t->sequencia = ler_u16(&src[2]);
+    t->instante_ms = ler_u32(&src[4]);
+    t->temperatura = (int16_t)ler_u16(&src[8]);
+    t->umidade = (int16_t)ler_u16(&src[10]);
+    t->angulo = (int16_t)ler_u16(&src[12]);
+    return true;
+}
+
+// ==================== FILTRO ====================
+
+// |a - b| > banda, sem estourar o int16
+static bool fora_da_banda(int16_t a, int16_t b, int16_t banda) {
+    int32_t d = (int32_t)a - (int32_t)b;
+    return (d < 0 ? -d : d) > banda;
+}
+
+void telemetria_filtro_init(telemetria_filtro_t *f) {
+    f->banda_temperatura = TELEMETRIA_BANDA_TEMPERATURA;
+    f->banda_umidade = TELEMETRIA_BANDA_UMIDADE;
+    f->banda_angulo = TELEMETRIA_BANDA_ANGULO;
+    f->heartbeat_ms = TELEMETRIA_HEARTBEAT_MS;
+    f->enviado_ms = 0;
+    f->tem_enviado = false;
+    f->aprovados = 0;
+    f->suprimidos = 0;
+}
+
+bool telemetria_filtro_avaliar(telemetria_filtro_t *f, telemetria_t *t, uint32_t agora_ms) {
+    const uint8_t estado = TELEMETRIA_FLAG_ALERTA | TELEMETRIA_FLAG_DADOS_VALIDOS;
+    bool enviar = !f->tem_enviado ||
+                  ((t->flags ^ f->enviado.flags) & estado) ||
+                  fora_da_banda(t->temperatura, f->enviado.temperatura, f->banda_temperatura) ||
+                  fora_da_banda(t->umidade, f->enviado.umidade, f->banda_umidade) ||
+                  fora_da_banda(t->angulo, f->enviado.angulo, f->banda_angulo);
+
+    if (!enviar && agora_ms - f->enviado_ms >= f->heartbeat_ms) {
+        t->flags |= TELEMETRIA_FLAG_HEARTBEAT;
+        enviar = true;
+    }
+
+    if (!enviar) {
+        f->suprimidos++;
+        return false;
+    }
+
+    f->enviado = *t;
+    f->enviado_ms = agora_ms;
+    f->tem_enviado = true;
+    f->aprovados++;
+    return true;
+}
+
+// ==================== FILA ====================
+
+void telemetria_fila_init(telemetria_fila_t *f) {
+    f->inicio = 0;
+    f->fim = 0;
+    f->descartados = 0;
+    f->profundidade_max = 0;
+}
+
+uint32_t telemetria_fila_profundidade(const telemetria_fila_t *f) {
+    return f->fim - f->inicio;
+}
+
+void telemetria_fila_inserir(telemetria_fila_t *f, const telemetria_t *t) {
+    if (telemetria_fila_profundidade(f) == TELEMETRIA_FILA_TAMANHO) {
+        f->inicio++;
+        f->descartados++;
+    }
+    f->registros[f->fim % TELEMETRIA_FILA_TAMANHO] = *t;
+    f->fim++;
+
+    uint32_t profundidade = telemetria_fila_profundidade(f);
+    if (profundidade > f->profundidade_max) {
+        f->profundidade_max = profundidade;
+    }
+}
+
+const telemetria_t *telemetria_fila_ver(const telemetria_fila_t *f, uint32_t i) {
+    if (i >= telemetria_fila_profundidade(f)) {
+        return NULL;
+    }
+    return &f->registros[(f->inicio + i) % TELEMETRIA_FILA_TAMANHO];
+}
+
+void telemetria_fila_remover(telemetria_fila_t *f, uint32_t n) {
+    uint32_t profundidade = telemetria_fila_profundidade(f);
+    f->inicio += (n < profundidade) ? n : profundidade;
+}
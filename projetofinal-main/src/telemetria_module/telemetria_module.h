@@ -0,0 +1,170 @@
+/**
+ * @file telemetria_module.h
+ * @brief Registro binário de telemetria da cama (MQTT e UART pro ESP32)
+ *
+ * Substitui o texto "%.1f,%.1f,%.1f,%d": os valores vão em ponto fixo
+ * (décimos, int16) num registro de tamanho fixo, little-endian, com versão,
+ * número de sequência, instante da amostra e CRC-8. São 15 bytes, então com
+ * o padding PKCS7 o registro cabe num bloco AES só.
+ *
+ * Layout (versão 1):
+ *   [0]      versão (TELEMETRIA_VERSAO)
+ *   [1]      flags (TELEMETRIA_FLAG_*)
+ *   [2..3]   sequência (uint16)
+ *   [4..7]   instante da amostra em ms desde o boot (uint32)
+ *   [8..9]   temperatura em décimos de °C (int16)
+ *   [10..11] umidade em décimos de % (int16)
+ *   [12..13] ângulo em décimos de grau (int16)
+ *   [14]     CRC-8 dos bytes 0..13 (polinômio 0x31, início 0xFF)
+ */
+
+#ifndef TELEMETRIA_MODULE_H
+#define TELEMETRIA_MODULE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// ==================== FORMATO ====================
+#define TELEMETRIA_VERSAO           1
+#define TELEMETRIA_TAMANHO          15
+
+#define TELEMETRIA_FLAG_ALERTA          0x01    // Ângulo fora da faixa
+#define TELEMETRIA_FLAG_DADOS_VALIDOS   0x02    // Já teve leitura boa dos sensores
+#define TELEMETRIA_FLAG_HEARTBEAT       0x04    // Nada mudou, saiu porque o silêncio estourou
+
+// Report-by-exception: um registro só sai quando algum canal se afasta do último
+// valor enviado mais que a banda morta dele (décimos), quando o alerta ou a
+// validade dos dados muda, ou quando fica TELEMETRIA_HEARTBEAT_MS sem enviar nada
+#ifndef TELEMETRIA_BANDA_TEMPERATURA
+#define TELEMETRIA_BANDA_TEMPERATURA    2       // 0.2 °C
+#endif
+#ifndef TELEMETRIA_BANDA_UMIDADE
+#define TELEMETRIA_BANDA_UMIDADE        10      // 1.0 %
+#endif
+#ifndef TELEMETRIA_BANDA_ANGULO
+#define TELEMETRIA_BANDA_ANGULO         5       // 0.5°
+#endif
+#ifndef TELEMETRIA_HEARTBEAT_MS
+#define TELEMETRIA_HEARTBEAT_MS         60000
+#endif
+
+// Fila de registros esperando rede: potência de 2, a 5 s por registro dá ~21 min sem broker
+#define TELEMETRIA_FILA_TAMANHO     256
+
+// ==================== ESTRUTURA ====================
+typedef struct {
+    uint16_t sequencia;         // Incrementa a cada registro gerado (buraco = perda)
+    uint32_t instante_ms;       // Quando a amostra foi feita (ms desde o boot)
+    int16_t temperatura;        // Décimos de °C
+    int16_t umidade;            // Décimos de %
+    int16_t angulo;             // Décimos de grau
+    uint8_t flags;              // TELEMETRIA_FLAG_*
+} telemetria_t;
+
+/**
+ * Filtro de report-by-exception. As bandas ficam na struct pra poderem ser
+ * ajustadas em tempo de execução (telemetria_filtro_init põe os padrões).
+ */
+typedef struct {
+    int16_t banda_temperatura;  // Décimos de °C (0 = qualquer mudança)
+    int16_t banda_umidade;      // Décimos de %
+    int16_t banda_angulo;       // Décimos de grau
+    uint32_t heartbeat_ms;      // Silêncio máximo
+    telemetria_t enviado;       // Último registro que passou no filtro
+    uint32_t enviado_ms;        // Quando ele passou
+    bool tem_enviado;           // false até o primeiro (que sempre passa)
+    uint32_t aprovados;         // Registros que passaram
+    uint32_t suprimidos;        // Registros segurados por estar dentro das bandas
+} telemetria_filtro_t;
+
+/**
+ * Fila circular de registros (store-and-forward). Cheia, descarta o mais
+ * antigo pra sempre guardar os últimos minutos. Não tem trava: só uma task
+ * deve inserir e remover.
+ */
+typedef struct {
+    telemetria_t registros[TELEMETRIA_FILA_TAMANHO];
+    uint32_t inicio;            // Contador livre do mais antigo (índice = inicio % TAMANHO)
+    uint32_t fim;               // Contador livre da próxima posição livre
+    uint32_t descartados;       // Registros perdidos por fila cheia
+    uint32_t profundidade_max;  // Maior ocupação desde o boot
+} telemetria_fila_t;
+
+// ==================== FUNÇÕES PÚBLICAS ====================
+
+/**
+ * @brief Preenche um registro a partir das leituras em float
+ *
+ * Arredonda pra décimos e satura na faixa do int16.
+ */
+void telemetria_montar(telemetria_t *t, uint16_t sequencia, uint32_t instante_ms,
+                       float temperatura, float umidade, float angulo,
+                       bool alerta, bool dados_validos);
+
+/**
+ * @brief Serializa o registro (TELEMETRIA_TAMANHO bytes, com CRC)
+ * @return Quantidade de bytes escritos em dst
+ */
+size_t telemetria_codificar(const telemetria_t *t, uint8_t *dst);
+
+/**
+ * @brief Lê um registro serializado
+ * @return false se o tamanho, a versão ou o CRC não baterem
+ */
+bool telemetria_decodificar(const uint8_t *src, size_t len, telemetria_t *t);
+
+/**
+ * @brief CRC-8 usado no registro (mesmo do AHT20: polinômio 0x31, início 0xFF)
+ */
+uint8_t telemetria_crc8(const uint8_t *dados, size_t len);
+
+// ==================== FILTRO ====================
+
+/**
+ * @brief Zera o filtro e põe as bandas/heartbeat padrão (TELEMETRIA_BANDA_*)
+ */
+void telemetria_filtro_init(telemetria_filtro_t *f);
+
+/**
+ * @brief Decide se o registro deve ser enviado
+ *
+ * Se passar, vira a nova referência das bandas; se saiu só pelo heartbeat,
+ * ganha TELEMETRIA_FLAG_HEARTBEAT.
+ *
+ * @param f Estado do filtro
+ * @param t Registro candidato (as flags podem ser alteradas)
+ * @param agora_ms Relógio atual em ms (conta o heartbeat mesmo se os sensores pararem)
+ * @return true se o registro deve ir pra fila
+ */
+bool telemetria_filtro_avaliar(telemetria_filtro_t *f, telemetria_t *t, uint32_t agora_ms);
+
+// ==================== FILA ====================
+
+/**
+ * @brief Esvazia a fila e zera os contadores
+ */
+void telemetria_fila_init(telemetria_fila_t *f);
+
+/**
+ * @brief Coloca um registro no fim da fila (cheia: descarta o mais antigo)
+ */
+void telemetria_fila_inserir(telemetria_fila_t *f, const telemetria_t *t);
+
+/**
+ * @brief Quantos registros estão esperando
+ */
+uint32_t telemetria_fila_profundidade(const telemetria_fila_t *f);
+
+/**
+ * @brief Registro na posição i a partir do mais antigo (sem remover)
+ * @return NULL se i passar da profundidade
+ */
+const telemetria_t *telemetria_fila_ver(const telemetria_fila_t *f, uint32_t i);
+
+/**
+ * @brief Remove os n registros mais antigos (depois de enviados)
+ */
+void telemetria_fila_remover(telemetria_fila_t *f, uint32_t n);
+
+#endif // TELEMETRIA_MODULE_H
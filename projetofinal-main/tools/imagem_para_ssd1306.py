@@ -0,0 +1,201 @@
+"""
+Conversor de imagens para o formato de páginas do SSD1306
+---------------------------------------------------------
+Lê imagens BMP (1, 8, 24 ou 32 bits, sem compressão) ou PNG (8 bits,
+sem entrelaçamento) e gera um .c/.h com os bytes já no layout da GDDRAM:
+cada byte é uma coluna de 8 pixels de uma página (bit 0 = linha de cima),
+páginas em sequência. Assim o firmware copia a imagem direto pro buffer
+com ssd1306_blit, sem decodificar nada em tempo de execução.
+
+Só usa a biblioteca padrão (o CMake chama este script durante o build).
+
+Uso:
+    python imagem_para_ssd1306.py --c imagens.c --h imagens.h assets/splash.bmp
+
+Cada arquivo vira um `const ssd1306_image_t imagem_<nome>` (nome = arquivo
+sem extensão). Pixel claro (luminância >= limiar) = pixel aceso no OLED;
+--inverter faz o contrário.
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+import zlib
+
+
+# ==================== LEITURA DAS IMAGENS ====================
+
+def ler_bmp(dados):
+    """Devolve (largura, altura, linhas) com a luminância 0-255 de cada pixel."""
+    if dados[:2] != b"BM":
+        raise ValueError("nao e um BMP")
+    offset = struct.unpack_from("<I", dados, 10)[0]
+    largura, altura, _, bpp, compressao = struct.unpack_from("<iiHHI", dados, 18)
+    if compressao not in (0, 3) or bpp not in (1, 8, 24, 32):
+        raise ValueError("BMP nao suportado (%d bpp, compressao %d)" % (bpp, compressao))
+
+    tam_cabecalho = struct.unpack_from("<I", dados, 14)[0]
+    paleta = []
+    if bpp <= 8:
+        inicio = 14 + tam_cabecalho
+        for i in range(inicio, offset, 4):
+            b, g, r = dados[i], dados[i + 1], dados[i + 2]
+            paleta.append(luminancia(r, g, b))
+
+    # Linhas são guardadas de baixo pra cima (altura positiva) e alinhadas em 4 bytes
+    de_cima = altura < 0
+    altura = abs(altura)
+    passo = ((largura * bpp + 31) // 32) * 4
+    linhas = []
+    for y in range(altura):
+        base = offset + (y if de_cima else altura - 1 - y) * passo
+        linha = []
+        for x in range(largura):
+            if bpp == 1:
+                indice = (dados[base + x // 8] >> (7 - x % 8)) & 1
+                linha.append(paleta[indice])
+            elif bpp == 8:
+                linha.append(paleta[dados[base + x]])
+            else:
+                i = base + x * (bpp // 8)
+                linha.append(luminancia(dados[i + 2], dados[i + 1], dados[i]))
+        linhas.append(linha)
+    return largura, altura, linhas
+
+
+def ler_png(dados):
+    """PNG de 8 bits por canal (cinza, RGB, paleta, com ou sem alfa), sem entrelaçamento."""
+    if dados[:8] != b"\x89PNG\r\n\x1a\n":
+        raise ValueError("nao e um PNG")
+    pos = 8
+    idat = b""
+    paleta = []
+    while pos < len(dados):
+        tamanho, tipo = struct.unpack_from(">I4s", dados, pos)
+        corpo = dados[pos + 8:pos + 8 + tamanho]
+        pos += 12 + tamanho
+        if tipo == b"IHDR":
+            largura, altura, profundidade, cor, _, _, entrelacado = struct.unpack(">IIBBBBB", corpo)
+        elif tipo == b"PLTE":
+            paleta = [luminancia(*corpo[i:i + 3]) for i in range(0, len(corpo), 3)]
+        elif tipo == b"IDAT":
+            idat += corpo
+        elif tipo == b"IEND":
+            break
+
+    canais = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}.get(cor)
+    if profundidade != 8 or canais is None or entrelacado:
+        raise ValueError("PNG nao suportado (profundidade %d, cor %d)" % (profundidade, cor))
+
+    bruto = zlib.decompress(idat)
+    passo = largura * canais
+    anterior = bytearray(passo)
+    linhas = []
+    pos = 0
+    for _ in range(altura):
+        filtro = bruto[pos]
+        atual = bytearray(bruto[pos + 1:pos + 1 + passo])
+        pos += 1 + passo
+        desfiltrar(filtro, atual, anterior, canais)
+
+        linha = []
+        for x in range(largura):
+            px = atual[x * canais:(x + 1) * canais]
+            if cor == 3:
+                linha.append(paleta[px[0]])
+            elif canais <= 2:
+                linha.append(px[0])
+            else:
+                linha.append(luminancia(px[0], px[1], px[2]))
+        linhas.append(linha)
+        anterior = atual
+    return largura, altura, linhas
+
+
+def desfiltrar(filtro, atual, anterior, bpp):
+    for i in range(len(atual)):
+        a = atual[i - bpp] if i >= bpp else 0
+        b = anterior[i]
+        c = anterior[i - bpp] if i >= bpp else 0
+        if filtro == 1:
+            atual[i] = (atual[i] + a) & 0xFF
+        elif filtro == 2:
+            atual[i] = (atual[i] + b) & 0xFF
+        elif filtro == 3:
+            atual[i] = (atual[i] + (a + b) // 2) & 0xFF
+        elif filtro == 4:
+            p = a + b - c
+            pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+            preditor = a if pa <= pb and pa <= pc else (b if pb <= pc else c)
+            atual[i] = (atual[i] + preditor) & 0xFF
+
+
+def luminancia(r, g, b):
+    return (299 * r + 587 * g + 114 * b) // 1000
+
+
+# ==================== CONVERSÃO ====================
+
+def para_paginas(largura, altura, linhas, limiar, inverter):
+    """Bytes no layout da GDDRAM: página por página, uma coluna de 8 pixels por byte."""
+    paginas = (altura + 7) // 8
+    saida = bytearray(largura * paginas)
+    for y in range(altura):
+        for x in range(largura):
+            aceso = (linhas[y][x] >= limiar) != inverter
+            if aceso:
+                saida[(y // 8) * largura + x] |= 1 << (y % 8)
+    return saida
+
+
+def nome_c(caminho):
+    base = os.path.splitext(os.path.basename(caminho))[0]
+    return "imagem_" + re.sub(r"\W", "_", base).lower()
+
+
+def gerar(imagens, caminho_c, caminho_h):
+    guarda = re.sub(r"\W", "_", os.path.basename(caminho_h)).upper()
+    with open(caminho_h, "w", newline="\n") as h:
+        h.write("// Gerado por tools/imagem_para_ssd1306.py, nao editar\n\n")
+        h.write("#ifndef %s\n#define %s\n\n#include \"ssd1306.h\"\n\n" % (guarda, guarda))
+        for nome, largura, altura, _ in imagens:
+            h.write("extern const ssd1306_image_t %s;  // %dx%d\n" % (nome, largura, altura))
+        h.write("\n#endif\n")
+
+    with open(caminho_c, "w", newline="\n") as c:
+        c.write("// Gerado por tools/imagem_para_ssd1306.py, nao editar\n\n")
+        c.write("#include \"%s\"\n" % os.path.basename(caminho_h))
+        for nome, largura, altura, dados in imagens:
+            c.write("\nstatic const uint8_t %s_dados[%d] = {\n" % (nome, len(dados)))
+            for i in range(0, len(dados), 16):
+                c.write("    " + ", ".join("0x%02x" % b for b in dados[i:i + 16]) + ",\n")
+            c.write("};\n\n")
+            c.write("const ssd1306_image_t %s = {%d, %d, %s_dados};\n" % (nome, largura, altura, nome))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Converte BMP/PNG para arrays de páginas do SSD1306")
+    parser.add_argument("imagens", nargs="+")
+    parser.add_argument("--c", required=True, help="arquivo .c de saída")
+    parser.add_argument("--h", required=True, help="arquivo .h de saída")
+    parser.add_argument("--limiar", type=int, default=128, help="luminância mínima de um pixel aceso")
+    parser.add_argument("--inverter", action="store_true", help="pixel escuro = aceso")
+    args = parser.parse_args()
+
+    imagens = []
+    for caminho in args.imagens:
+        with open(caminho, "rb") as f:
+            dados = f.read()
+        largura, altura, linhas = ler_png(dados) if dados[:4] == b"\x89PNG" else ler_bmp(dados)
+        if largura > 128 or altura > 64:
+            sys.exit("%s: %dx%d nao cabe no display (128x64)" % (caminho, largura, altura))
+        imagens.append((nome_c(caminho), largura, altura,
+                        para_paginas(largura, altura, linhas, args.limiar, args.inverter)))
+
+    gerar(imagens, args.c, args.h)
+
+
+if __name__ == "__main__":
+    main()